@@ -0,0 +1,135 @@
+#ifndef ALGORITHM_REGISTRY_H
+#define ALGORITHM_REGISTRY_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AlgorithmResult.h"
+#include "Span.h"
+
+/**
+ * What an engine does with an AlgorithmRequest, as bit flags. An engine has exactly
+ * one of SORTS, SELECTS and SELECTS_MANY, plus any of the modifiers.
+ */
+enum AlgorithmCapability : unsigned {
+    SORTS = 1u << 0,         // sorts data in place, result.sorted views it
+    SELECTS = 1u << 1,       // finds the element of rank k, result.value
+    SELECTS_MANY = 1u << 2,  // finds every rank in ranks at once, result.values
+    APPROXIMATE = 1u << 3,   // the answer is only close to the requested rank
+    PARALLEL = 1u << 4       // runs on threads threads, compared against a baseline engine
+};
+
+/**
+ * Input of one engine call. data is a working copy the engine may reorder; the
+ * other fields are only read by engines with the matching capability.
+ */
+struct AlgorithmRequest {
+    Span<int> data;
+    size_t k = 0;
+    const std::vector<size_t>* ranks = nullptr;
+};
+
+using AlgorithmRunner = std::function<AlgorithmResult(const AlgorithmRequest&)>;
+
+struct AlgorithmEntry {
+    // Key used in configurations (algorithms=quick_sort,merge_sort)
+    std::string id;
+    // Name written to the results
+    std::string name;
+    unsigned capabilities = 0;
+    // Creates a runner owning a fresh engine. The benchmark calls it once per thread
+    // (and thread count), so engines may keep scratch buffers across calls
+    std::function<AlgorithmRunner(size_t threads)> make;
+    // APPROXIMATE engines: quantile they estimate, instead of rank k, when >= 0,
+    // and the rank error tolerated as a fraction of n
+    double quantile = -1.0;
+    double epsilon = 0.0;
+    // PARALLEL engines: id of the sequential engine speedup is measured against
+    std::string baseline = "";
+
+    bool has(unsigned capability) const {
+        return (capabilities & capability) != 0;
+    }
+};
+
+/**
+ * @class AlgorithmRegistry
+ * @brief Every sorting and selection engine the benchmark can run.
+ *
+ * Each algorithm header registers its engines at static initialization through
+ * AlgorithmRegistry::add, so a new engine only needs its own header included. The
+ * benchmark picks the engines for a configuration by capability and, optionally,
+ * by id, and writes one result row per engine.
+ */
+class AlgorithmRegistry {
+private:
+    static std::vector<AlgorithmEntry>& entries() {
+        static std::vector<AlgorithmEntry> registered;
+        return registered;
+    }
+
+public:
+    // Returns true so registrations can initialize a static variable
+    static bool add(AlgorithmEntry entry) {
+        for (const AlgorithmEntry& existing : entries()) {
+            if (existing.id == entry.id) {
+                throw std::logic_error("algorithm " + entry.id + " registered twice");
+            }
+        }
+        entries().push_back(std::move(entry));
+        return true;
+    }
+
+    static const std::vector<AlgorithmEntry>& all() {
+        return entries();
+    }
+
+    static const AlgorithmEntry* find(const std::string& id) {
+        for (const AlgorithmEntry& entry : entries()) {
+            if (entry.id == id) return &entry;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Engines having any of the capabilities, in registration order.
+     * @param ids Restricts the result to these ids, in this order; empty for all
+     * @throws std::invalid_argument for an unknown id or one without the capabilities
+     */
+    static std::vector<const AlgorithmEntry*> select(unsigned capabilities, const std::vector<std::string>& ids = {}) {
+        std::vector<const AlgorithmEntry*> selected;
+        if (ids.empty()) {
+            for (const AlgorithmEntry& entry : entries()) {
+                if (entry.has(capabilities)) selected.push_back(&entry);
+            }
+            return selected;
+        }
+        for (const std::string& id : ids) {
+            const AlgorithmEntry* entry = find(id);
+            if (entry == nullptr) {
+                throw std::invalid_argument("unknown algorithm '" + id + "'");
+            }
+            if (!entry->has(capabilities)) {
+                throw std::invalid_argument("algorithm '" + id + "' does not apply to this benchmark type");
+            }
+            selected.push_back(entry);
+        }
+        return selected;
+    }
+};
+
+/**
+ * AlgorithmEntry::make for an engine that needs no thread count: constructs an
+ * Engine from args and runs it with call(engine, request).
+ */
+template <typename Engine, typename Call, typename... Args>
+std::function<AlgorithmRunner(size_t)> engineFactory(Call call, Args... args) {
+    return [=](size_t) -> AlgorithmRunner {
+        auto engine = std::make_shared<Engine>(args...);
+        return [engine, call](const AlgorithmRequest& request) { return call(*engine, request); };
+    };
+}
+
+#endif // ALGORITHM_REGISTRY_H
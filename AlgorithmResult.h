@@ -4,33 +4,107 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "Span.h"
+
+/**
+ * Hardware counter values over one algorithm call (see PerfCounters.h),
+ * -1 for events that could not be measured
+ */
+struct HardwareCounters {
+    int64_t cycles = -1;
+    int64_t instructions = -1;
+    int64_t cache_misses = -1;
+    int64_t branch_misses = -1;
+};
+
+/**
+ * Measured memory use over one algorithm call (see MemoryTracker.h)
+ */
+struct MemoryCounters {
+    size_t peak_heap_bytes = 0;      // highest heap footprint above the level at the start of the call
+    size_t retained_heap_bytes = 0;  // still allocated on return, including the returned result
+    uint64_t allocations = 0;        // calls to operator new
+    size_t peak_rss_bytes = 0;       // process peak resident set size during the call
+    size_t stack_bytes = 0;          // stack high-water mark of the calling thread
+};
 
 /**
  * Structure to hold the results of algorithm execution
  * For selection algorithms (QuickSelect, SelectLinear):
  *   - value: the k-th smallest element
- *   - result: empty vector (not used)
  * For sorting algorithms (QuickSort, MergeSort):
- *   - value: 0 (not used)
- *   - result: sorted vector
+ *   - sorted: view of the caller's buffer, sorted in place; empty when the
+ *     output is not in memory (ExternalMergeSort)
+ * For multi-rank selection (MultiSelect):
+ *   - values: one selected element per requested rank
  */
 struct AlgorithmResult {
     std::string algorithm_name = "";
     int value = 0;                    // For selection algorithms
-    std::vector<int> result;          // For sorting algorithms
+    Span<const int> sorted;           // For sorting algorithms, does not own the data
+    std::vector<int> values;          // For multi-rank selection algorithms
     double execution_time = 0.0;      // in milliseconds
     uint64_t comparisons = 0;         // number of comparisons
-    size_t memory_usage = 0;          // in bytes
+    size_t memory_usage = 0;          // in bytes; the algorithm's estimate until the harness measures it
+    uint64_t vector_comparisons = 0;  // SIMD compare operations, counted apart from comparisons
+    uint64_t swaps = 0;               // element swaps, when the metrics policy counts them
+    HardwareCounters hardware;        // filled in by the benchmark harness, not the algorithm
+    MemoryCounters memory;            // filled in by the benchmark harness, not the algorithm
 
     // Constructor for selection algorithms
     static AlgorithmResult forSelection(std::string algorithm_name, int val, double time, uint64_t comps, size_t mem) {
-        return {algorithm_name, val, {}, time, comps, mem};
+        AlgorithmResult result = make(std::move(algorithm_name), time, comps, mem);
+        result.value = val;
+        return result;
     }
 
     // Constructor for sorting algorithms
-    static AlgorithmResult forSorting(std::string algorithm_name, std::vector<int>&& res, double time, uint64_t comps, size_t mem) {
-        return {algorithm_name, 0, std::move(res), time, comps, mem};
+    static AlgorithmResult forSorting(std::string algorithm_name, Span<const int> sorted, double time, uint64_t comps, size_t mem) {
+        AlgorithmResult result = make(std::move(algorithm_name), time, comps, mem);
+        result.sorted = sorted;
+        return result;
+    }
+
+    // Constructor for multi-rank selection algorithms
+    static AlgorithmResult forMultiSelection(std::string algorithm_name, std::vector<int>&& values, double time, uint64_t comps, size_t mem) {
+        AlgorithmResult result = make(std::move(algorithm_name), time, comps, mem);
+        result.values = std::move(values);
+        return result;
+    }
+
+private:
+    // Fields every algorithm reports; the others keep their defaults
+    static AlgorithmResult make(std::string algorithm_name, double time, uint64_t comps, size_t mem) {
+        AlgorithmResult result;
+        result.algorithm_name = std::move(algorithm_name);
+        result.execution_time = time;
+        result.comparisons = comps;
+        result.memory_usage = mem;
+        return result;
     }
 };
 
+// AlgorithmResult::sorted for a sort over T: the data itself for int, empty for
+// other element types, whose callers check the data directly
+template <typename T>
+inline Span<const int> sortedView(Span<T> data) {
+    if constexpr (std::is_same<std::remove_const_t<T>, int>::value) {
+        return data;
+    } else {
+        return {};
+    }
+}
+
+// AlgorithmResult::value for a selection over T: the element for int, 0 otherwise
+template <typename T>
+inline int selectedValue(const T& element) {
+    if constexpr (std::is_same<T, int>::value) {
+        return element;
+    } else {
+        return 0;
+    }
+}
+
 #endif // ALGORITHM_RESULT_H
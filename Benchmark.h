@@ -11,21 +11,58 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <cstring>
+#include <limits>
 #include "AlgorithmResult.h"
 #include "algorithms/MergeSort.h"       
 #include "algorithms/QuickSort.h"      
 #include "algorithms/SelectLinear.h" 
 #include "algorithms/QuickSelect.h"
+#include "algorithms/SelectLinearInPlace.h"
+#include "algorithms/FloydRivestSelect.h"
+#include "algorithms/MultiSelect.h"
+#include "algorithms/StreamingSelect.h"
+#include "ChunkSource.h"
+#include "algorithms/ExternalMergeSort.h"
+#include <filesystem>
+#include "algorithms/ParallelMergeSort.h"
+#include "algorithms/ParallelQuickSelect.h"
+#include "algorithms/IntroSort.h"
+#include "algorithms/RadixSort.h"
+#include "algorithms/NaturalMergeSort.h"
+#include "algorithms/RecordSort.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h"
+#include "MemoryTracker.h"
+#include "CpuAffinity.h"
+#include "ResultSink.h"
+#include "InputGenerator.h"
+#include "InputArena.h"
+#include "PageAllocator.h"
+#include "AlgorithmRegistry.h"
+#include <map>
+#include <tuple>
+#include <memory>
 
 enum class AlgorithmType {
     SELECTION,  
-    SORTING     
+    SORTING,
+    EXTERNAL_SORTING,
+    RECORD_SORTING,
+    LARGE_SCALE,
+    STREAMING_SELECTION
 };
 
 enum class TestCaseType {
     RANDOM,         
     NEARLY_SORTED,   
-    REVERSE_SORTED  
+    REVERSE_SORTED,
+    FEW_UNIQUE,
+    ZIPF,
+    ORGAN_PIPE,
+    SAWTOOTH,
+    SORTED_RUNS,
+    ALL_EQUAL
 };
 
 struct BenchmarkConfig {
@@ -33,17 +70,53 @@ struct BenchmarkConfig {
     size_t vector_size;
     TestCaseType test_case;
     std::string test_name;
+    // Thread counts to run the PARALLEL engines with (sorting and selection, empty to skip them)
+    std::vector<size_t> thread_counts = {};
+    // Numbers of ranks to find at once with the SELECTS_MANY engines (selection only, empty to skip them)
+    std::vector<size_t> rank_counts = {};
+    // RAM budget in bytes and merge fan-in of the external sort (external sorting only)
+    size_t memory_budget = 0;
+    size_t fan_in = 16;
+    // Payload sizes in bytes of the (key, payload) records, each one of RECORD_PAYLOAD_SIZES (record sorting only)
+    std::vector<size_t> payload_sizes = {};
+    // Seed of the input generator, 0 for a fresh random input on every call;
+    // seeded inputs are generated once and served from Benchmark's input cache
+    uint64_t seed = 0;
+    // Ids of the registered engines to compare (see AlgorithmRegistry.h), empty for
+    // every engine that applies to the algorithm type
+    std::vector<std::string> algorithms = {};
+    // Placements of the engines' working copy and scratch buffers (see PageAllocator.h),
+    // each engine running once per placement; empty for a single run with the default
+    // allocator and plain engine names (sorting and selection only)
+    std::vector<MemoryPlacement> placements = {};
 };
 
 class Benchmark {
 public:
+    // Key type of the large-scale tier, wide enough for keys up to 10 * size at any size
+    using LargeKey = int64_t;
+
     struct BenchmarkResult {
         std::string algorithm_name;
-        TestCaseType test_case;
-        size_t input_size;
-        double execution_time_ms; 
-        size_t comparisons;        
-        size_t memory_usage;        
+        TestCaseType test_case = TestCaseType::RANDOM;
+        size_t input_size = 0;
+        double execution_time_ms = 0.0;
+        size_t comparisons = 0;
+        size_t memory_usage = 0;
+        size_t threads = 0;         // 0 for sequential algorithms
+        size_t ranks = 0;           // ranks found at once, 0 for single-rank selection and sorting
+        size_t payload_bytes = 0;   // record payload size, 0 for plain int keys
+        MemoryPlacement placement = MemoryPlacement::DEFAULT;  // of the working copy and scratch buffers
+        double speedup = std::nan("");     // baseline time / parallel time, parallel engines only
+        double efficiency = std::nan("");  // speedup / threads
+        size_t vector_comparisons = 0;
+        uint64_t swaps = 0;            // only counted by the CountComparisonsAndSwaps runs
+        HardwareCounters hardware;     // -1 for events perf_event_open could not measure
+        MemoryCounters memory;
+        uint64_t bytes_read = 0;       // external sorting and streaming selection only
+        uint64_t bytes_written = 0;
+        size_t passes = 0;
+        double throughput_mb_s = 0.0;
     };
 
     static std::string get_test_case_name(TestCaseType test_case) {
@@ -51,12 +124,26 @@ public:
             case TestCaseType::RANDOM: return "random";
             case TestCaseType::NEARLY_SORTED: return "nearly_sorted";
             case TestCaseType::REVERSE_SORTED: return "reverse_sorted";
+            case TestCaseType::FEW_UNIQUE: return "few_unique";
+            case TestCaseType::ZIPF: return "zipf";
+            case TestCaseType::ORGAN_PIPE: return "organ_pipe";
+            case TestCaseType::SAWTOOTH: return "sawtooth";
+            case TestCaseType::SORTED_RUNS: return "sorted_runs";
+            case TestCaseType::ALL_EQUAL: return "all_equal";
             default: return "unknown";
         }
     }
 
     static std::string generate_filename(const BenchmarkConfig& config) {
-        std::string algo_type = (config.algorithm_type == AlgorithmType::SELECTION) ? "selection" : "sorting";
+        std::string algo_type;
+        switch (config.algorithm_type) {
+            case AlgorithmType::SELECTION: algo_type = "selection"; break;
+            case AlgorithmType::SORTING: algo_type = "sorting"; break;
+            case AlgorithmType::EXTERNAL_SORTING: algo_type = "external_sorting"; break;
+            case AlgorithmType::RECORD_SORTING: algo_type = "record_sorting"; break;
+            case AlgorithmType::LARGE_SCALE: algo_type = "large_scale"; break;
+            case AlgorithmType::STREAMING_SELECTION: algo_type = "streaming_selection"; break;
+        }
         std::string test_case = get_test_case_name(config.test_case);
         
         std::ostringstream filename;
@@ -67,127 +154,792 @@ public:
         return filename.str();
     }
 
-    static void run_benchmark(const BenchmarkConfig& config) {
-        std::vector<int> test_vector;
-        switch (config.test_case) {
-            case TestCaseType::RANDOM:
-                test_vector = generate_random_vector(config.vector_size);
-                break;
-            case TestCaseType::NEARLY_SORTED:
-                test_vector = generate_nearly_sorted_vector(config.vector_size);
-                break;
-            case TestCaseType::REVERSE_SORTED:
-                test_vector = generate_reverse_sorted_vector(config.vector_size);
-                break;
+    // Capabilities of the registered engines a benchmark type runs
+    static unsigned engine_capabilities(AlgorithmType type) {
+        switch (type) {
+            case AlgorithmType::SORTING: return SORTS;
+            case AlgorithmType::SELECTION: return SELECTS | SELECTS_MANY;
+            case AlgorithmType::EXTERNAL_SORTING: return 0;
+            case AlgorithmType::RECORD_SORTING: return 0;
+            case AlgorithmType::LARGE_SCALE: return 0;
+            case AlgorithmType::STREAMING_SELECTION: return 0;
         }
+        return 0;
+    }
 
-        AlgorithmResult first_result;
-        AlgorithmResult second_result;
-        
-        if (config.algorithm_type == AlgorithmType::SELECTION) {
-            SelectLinear select_linear;
-            std::vector<int> select_linear_vector = test_vector;
-            // 7th smallest element (index 6 in 0-based indexing)
-            first_result = select_linear.selectLinearWithMetrics(select_linear_vector, 6);
-            first_result.algorithm_name = "SelectLinear";
-
-            QuickSelect quick_select;
-            std::vector<int> quick_select_vector = test_vector;
-            second_result = quick_select.quickSelectWithMetrics(quick_select_vector, 6);
-            second_result.algorithm_name = "QuickSelect";
-        } else if (config.algorithm_type == AlgorithmType::SORTING) {
-            MergeSort merge_sorter;
-            std::vector<int> merge_sort_vector = test_vector;
-            first_result = merge_sorter.sortWithMetrics(merge_sort_vector);
-            first_result.algorithm_name = "MergeSort";
-
-            QuickSort quick_sorter;
-            std::vector<int> quick_sort_vector = test_vector;
-            second_result = quick_sorter.sortWithMetrics(quick_sort_vector);
-            second_result.algorithm_name = "QuickSort";
-        }
-
-        std::vector<BenchmarkResult> results = {
-            {first_result.algorithm_name, config.test_case, config.vector_size, 
-             first_result.execution_time, first_result.comparisons, first_result.memory_usage},
-            {second_result.algorithm_name, config.test_case, config.vector_size, 
-             second_result.execution_time, second_result.comparisons, second_result.memory_usage}
-        };
+    // Payload sizes the record sorting benchmark is compiled for
+    static constexpr size_t RECORD_PAYLOAD_SIZES[] = {4, 8, 16, 32, 64};
 
-        std::string filename = generate_filename(config);
-        save_results_to_csv(results, filename, config.algorithm_type);
+    /**
+     * Input of the configuration, generated in parallel on the first request for its
+     * (test case, size, seed) and shared by every later one. Unseeded configurations
+     * get a fresh input on every call. The large-scale tier draws its own 64-bit keys
+     * (generate_large_input) and gets an empty input here.
+     */
+    static InputCache::Input generate_input(const BenchmarkConfig& config) {
+        if (config.algorithm_type == AlgorithmType::LARGE_SCALE) {
+            return std::make_shared<const std::vector<int>>();
+        }
+        static InputCache cache(INPUT_CACHE_BYTES);
+        InputCache::Key key{static_cast<int>(config.test_case), config.vector_size, config.seed};
+        return cache.get(key, [&] {
+            return generate_keys<int>(config.test_case, config.vector_size, InputGenerator::resolveSeed(config.seed));
+        });
     }
-    
-    static void save_results_to_csv(const std::vector<BenchmarkResult>& results, const std::string& filename, AlgorithmType type) {
-        std::ofstream outfile(filename, std::ios::app);
-        
-        if (outfile.tellp() == 0) {
-            if (type == AlgorithmType::SELECTION) {
-                outfile << "Test Case,Input Size,Execution Time (ms) Select Linear,Execution Time (ms) QuickSelect,Comparisons Select Linear,Comparisons QuickSelect,Memory Usage (bytes) Select Linear,Memory Usage (bytes) QuickSelect\n";
-            } else if (type == AlgorithmType::SORTING) {
-                outfile << "Test Case,Input Size,Execution Time (ms) Quick Sort,Execution Time (ms) Merge Sort,Comparisons Quick Sort,Comparisons Merge Sort,Memory Usage (bytes) Quick Sort,Memory Usage (bytes) Merge Sort\n";
+
+    // 64-bit keys of the large-scale tier; only the most recent input stays cached
+    static BasicInputCache<LargeKey>::Input generate_large_input(const BenchmarkConfig& config) {
+        static BasicInputCache<LargeKey> cache(0);
+        BasicInputCache<LargeKey>::Key key{static_cast<int>(config.test_case), config.vector_size, config.seed};
+        return cache.get(key, [&] {
+            return generate_keys<LargeKey>(config.test_case, config.vector_size, InputGenerator::resolveSeed(config.seed));
+        });
+    }
+
+    /**
+     * Runs every engine of the configuration once on test_vector and returns one
+     * result per engine run, in registration order. Sorted outputs, exact selections
+     * of one or many ranks and the rank error of approximate selections are checked;
+     * a wrong answer throws std::runtime_error.
+     */
+    static std::vector<BenchmarkResult> run_iteration(const BenchmarkConfig& config, const std::vector<int>& test_vector) {
+        // Every algorithm call below runs inside measure_run, which attaches the
+        // hardware counts and the measured memory use to its result
+        thread_local PerfCounters counters;
+        static const bool warned = [] {
+            if (!counters.available()) {
+                std::cerr << "Warning: hardware performance counters unavailable, their CSV columns stay empty\n";
             }
+            if (!MemoryTracker::available()) {
+                std::cerr << "Warning: operator new hooks not installed, memory usage falls back to the algorithms' estimates\n";
+            }
+            return true;
+        }();
+        (void)warned;
+
+        std::vector<BenchmarkResult> results;
+        if (config.algorithm_type == AlgorithmType::EXTERNAL_SORTING) {
+            results.push_back(run_external_sorting(config, test_vector, counters));
+            return results;
         }
-        
+        if (config.algorithm_type == AlgorithmType::LARGE_SCALE) {
+            run_large_scale(config, counters, results);
+            return results;
+        }
+        if (config.algorithm_type == AlgorithmType::STREAMING_SELECTION) {
+            run_streaming_selection(config, test_vector, counters, results);
+            return results;
+        }
+        if (config.algorithm_type == AlgorithmType::RECORD_SORTING) {
+            run_argsort(config, test_vector, counters, results);
+            for (size_t payload_bytes : config.payload_sizes) {
+                switch (payload_bytes) {
+                    case 4: run_record_sorting<4>(config, test_vector, counters, results); break;
+                    case 8: run_record_sorting<8>(config, test_vector, counters, results); break;
+                    case 16: run_record_sorting<16>(config, test_vector, counters, results); break;
+                    case 32: run_record_sorting<32>(config, test_vector, counters, results); break;
+                    case 64: run_record_sorting<64>(config, test_vector, counters, results); break;
+                    default: throw std::invalid_argument("Unsupported record payload size " + std::to_string(payload_bytes));
+                }
+            }
+            return results;
+        }
+
+        // Engines run on a copy of test_vector restored into the arena right before
+        // each call, outside the algorithm's timer and the measured scope
+        thread_local InputArena arena;
+        AlgorithmRequest request;
+        request.k = std::min(SELECTION_RANK, std::max<size_t>(test_vector.size(), 1) - 1);
+        int exact_value = 0;
+        if (config.algorithm_type == AlgorithmType::SELECTION && !test_vector.empty()) {
+            Span<int> reference = arena.restore(test_vector);
+            std::nth_element(reference.begin(), reference.begin() + request.k, reference.end());
+            exact_value = reference[request.k];
+        }
+        // Exact answers of the SELECTS_MANY engines for every rank count, read off one sorted copy
+        std::map<size_t, std::vector<int>> exact_values;
+        if (config.algorithm_type == AlgorithmType::SELECTION && !config.rank_counts.empty() && !test_vector.empty()) {
+            Span<int> reference = arena.restore(test_vector);
+            std::sort(reference.begin(), reference.end());
+            for (size_t rank_count : config.rank_counts) {
+                std::vector<int>& values = exact_values[rank_count];
+                for (size_t k : generate_ranks(config.vector_size, rank_count)) {
+                    values.push_back(reference[k]);
+                }
+            }
+        }
+
+        auto run = [&](const AlgorithmEntry& entry, size_t threads, MemoryPlacement placement, std::string name) {
+            AlgorithmRunner& runner = get_runner(entry, threads, placement);
+            request.data = arena.restore(test_vector);
+            AlgorithmResult algorithm_result = measure_run(counters, [&] { return runner(request); });
+
+            if (entry.has(SORTS) && !std::is_sorted(algorithm_result.sorted.begin(), algorithm_result.sorted.end())) {
+                throw std::runtime_error(name + " left its input unsorted");
+            }
+            if (entry.has(SELECTS) && !entry.has(APPROXIMATE) && algorithm_result.value != exact_value) {
+                throw std::runtime_error(name + " returned " + std::to_string(algorithm_result.value) +
+                                         ", the exact answer is " + std::to_string(exact_value));
+            }
+            if (entry.has(SELECTS_MANY) && !test_vector.empty()) {
+                check_values(name, *request.ranks, algorithm_result.values, exact_values.at(request.ranks->size()));
+            }
+            if (entry.has(APPROXIMATE)) {
+                size_t target = entry.quantile >= 0.0 ? static_cast<size_t>(entry.quantile * test_vector.size()) : request.k;
+                VectorChunkSource source(test_vector);
+                check_rank_error(name, target, entry.epsilon * test_vector.size(), algorithm_result.value,
+                                 rank_interval(source, algorithm_result.value));
+            }
+
+            BenchmarkResult result = make_result(config, name, algorithm_result);
+            result.threads = threads;
+            result.placement = placement;
+            result.vector_comparisons = algorithm_result.vector_comparisons;
+            // The counters follow the calling thread only, not the pool workers of a
+            // parallel engine, so its counts would cover a fraction of the work: leave them empty
+            if (entry.has(PARALLEL)) {
+                result.hardware = HardwareCounters();
+            }
+            results.push_back(result);
+        };
+
+        // Parallel runs as (result index, result name of the baseline engine)
+        std::vector<std::pair<size_t, std::string>> parallel_runs;
+        std::vector<MemoryPlacement> placements = config.placements;
+        if (placements.empty()) placements.push_back(MemoryPlacement::DEFAULT);
+        for (MemoryPlacement placement : placements) {
+            // Buffers the engines and the arena allocate from here on follow the placement
+            PageAllocator::Scope placement_scope(placement);
+            std::string suffix = config.placements.empty() ? "" : " " + PageAllocator::name(placement);
+
+            for (const AlgorithmEntry* entry : AlgorithmRegistry::select(engine_capabilities(config.algorithm_type), config.algorithms)) {
+                if (entry->has(PARALLEL)) {
+                    const AlgorithmEntry* baseline = AlgorithmRegistry::find(entry->baseline);
+                    for (size_t thread_count : config.thread_counts) {
+                        run(*entry, thread_count, placement, entry->name + " " + std::to_string(thread_count) + "T" + suffix);
+                        parallel_runs.emplace_back(results.size() - 1, baseline != nullptr ? baseline->name + suffix : "");
+                    }
+                } else if (entry->has(SELECTS_MANY)) {
+                    for (size_t rank_count : config.rank_counts) {
+                        std::vector<size_t> ks = generate_ranks(config.vector_size, rank_count);
+                        request.ranks = &ks;
+                        run(*entry, 0, placement, entry->name + " " + std::to_string(rank_count) + " Ranks" + suffix);
+                        results.back().ranks = rank_count;
+                        request.ranks = nullptr;
+                    }
+                } else {
+                    run(*entry, 0, placement, entry->name + suffix);
+                }
+            }
+        }
+
+        // Speedup of each parallel run against its sequential baseline with the same placement, when that ran too
+        for (const auto& parallel_run : parallel_runs) {
+            BenchmarkResult& result = results[parallel_run.first];
+            for (const BenchmarkResult& sequential : results) {
+                if (!parallel_run.second.empty() && sequential.algorithm_name == parallel_run.second) {
+                    result.speedup = sequential.execution_time_ms / result.execution_time_ms;
+                    result.efficiency = result.speedup / result.threads;
+                }
+            }
+        }
+        return results;
+    }
+    
+    // <name>_benchmark.csv -> <name>_benchmark.bin
+    static std::string columnar_filename(const std::string& csv_filename) {
+        return csv_filename.substr(0, csv_filename.size() - 4) + ".bin";
+    }
+
+    /**
+     * Adds one iteration in long format: one row per algorithm run with the same
+     * columns for every algorithm, so any number of engines fits the same schema.
+     * run numbers the iterations of a configuration. Unmeasured counters, undefined
+     * ratios and columns that do not apply to the algorithm are stored as missing values.
+     */
+    static void append_results(ResultSink& sink, const std::vector<BenchmarkResult>& results, AlgorithmType type, size_t run) {
         auto get_test_case_name = [](TestCaseType test_case) -> std::string {
             switch (test_case) {
                 case TestCaseType::RANDOM: return "Random";
                 case TestCaseType::NEARLY_SORTED: return "Nearly Sorted";
                 case TestCaseType::REVERSE_SORTED: return "Reverse Sorted";
+                case TestCaseType::FEW_UNIQUE: return "Few Unique";
+                case TestCaseType::ZIPF: return "Zipf";
+                case TestCaseType::ORGAN_PIPE: return "Organ Pipe";
+                case TestCaseType::SAWTOOTH: return "Sawtooth";
+                case TestCaseType::SORTED_RUNS: return "Sorted Runs";
+                case TestCaseType::ALL_EQUAL: return "All Equal";
                 default: return "Unknown";
             }
         };
-        
-        outfile << get_test_case_name(results[0].test_case) << ","
-               << results[0].input_size << ","
-               << results[1].execution_time_ms << ","
-               << results[0].execution_time_ms << ","
-               << results[1].comparisons << ","
-               << results[0].comparisons << ","
-               << results[1].memory_usage << ","
-               << results[0].memory_usage << "\n";
-        
-        outfile.close();
+        auto count = [](uint64_t value) { return static_cast<int64_t>(value); };
+        auto optional_count = [](int64_t value) { return value >= 0 ? value : ResultSink::NULL_INT; };
+        auto ratio = [](int64_t numerator, double denominator) {
+            return numerator >= 0 && denominator > 0 ? numerator / denominator : std::nan("");
+        };
+        bool external = type == AlgorithmType::EXTERNAL_SORTING || type == AlgorithmType::STREAMING_SELECTION;
+        bool throughput = external || type == AlgorithmType::LARGE_SCALE;
+
+        for (const auto& result : results) {
+            const HardwareCounters& hardware = result.hardware;
+            sink.add("Test Case", get_test_case_name(result.test_case));
+            sink.add("Input Size", count(result.input_size));
+            sink.add("Run", count(run));
+            sink.add("Algorithm", result.algorithm_name);
+            sink.add("Threads", count(result.threads));
+            sink.add("Ranks", count(result.ranks));
+            sink.add("Payload (bytes)", count(result.payload_bytes));
+            sink.add("Placement", PageAllocator::name(result.placement));
+            sink.add("Execution Time (ms)", result.execution_time_ms);
+            sink.add("Comparisons", count(result.comparisons));
+            sink.add("Memory Usage (bytes)", count(result.memory_usage));
+            sink.add("SIMD Compares", count(result.vector_comparisons));
+            sink.add("Swaps", count(result.swaps));
+            sink.add("Cycles", optional_count(hardware.cycles));
+            sink.add("Instructions", optional_count(hardware.instructions));
+            sink.add("Cache Misses", optional_count(hardware.cache_misses));
+            sink.add("Branch Mispredicts", optional_count(hardware.branch_misses));
+            sink.add("IPC", ratio(hardware.instructions, static_cast<double>(hardware.cycles)));
+            sink.add("Cache Misses/Element", ratio(hardware.cache_misses, static_cast<double>(result.input_size)));
+            sink.add("Branch Mispredicts/Comparison", ratio(hardware.branch_misses, static_cast<double>(result.comparisons)));
+            sink.add("Peak Heap (bytes)", count(result.memory.peak_heap_bytes));
+            sink.add("Allocations", count(result.memory.allocations));
+            sink.add("Peak RSS (bytes)", count(result.memory.peak_rss_bytes));
+            sink.add("Stack (bytes)", count(result.memory.stack_bytes));
+            sink.add("Speedup", result.speedup);
+            sink.add("Efficiency", result.efficiency);
+            sink.add("Bytes Read", external ? count(result.bytes_read) : ResultSink::NULL_INT);
+            sink.add("Bytes Written", external ? count(result.bytes_written) : ResultSink::NULL_INT);
+            sink.add("Passes", external ? count(result.passes) : ResultSink::NULL_INT);
+            sink.add("Throughput (MB/s)", throughput ? result.throughput_mb_s : std::nan(""));
+            sink.endRow();
+        }
     }
     
 private:
-    static std::vector<int> generate_random_vector(size_t size) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> distrib(1, size * 10);
-        
-        std::vector<int> vec(size);
-        for (auto& elem : vec) {
-            elem = distrib(gen);
+    /**
+     * Runs one algorithm call with hardware counters and memory tracking around it.
+     * When the operator new hooks are installed, memory_usage is replaced by the
+     * measured peak heap plus stack high-water mark. In-place algorithms work on the
+     * InputArena, which is allocated beforehand and so not part of either.
+     */
+    template <typename Run>
+    static AlgorithmResult measure_run(PerfCounters& counters, Run&& run) {
+        // Reset and paint before the counters start so neither shows up in them
+        MemoryTracker::resetPeakRss();
+        MemoryTracker::paintStack();
+        MemoryTracker::Scope heap;
+
+        AlgorithmResult result = counters.measure(std::forward<Run>(run));
+
+        heap.collect(result.memory);
+        result.memory.stack_bytes = MemoryTracker::stackHighWater();
+        result.memory.peak_rss_bytes = MemoryTracker::peakRss();
+        if (MemoryTracker::available()) {
+            result.memory_usage = result.memory.peak_heap_bytes + result.memory.stack_bytes;
+        }
+        return result;
+    }
+
+    /**
+     * Writes test_vector to a temporary binary file, sorts it out of core and
+     * checks the output. Writing the input and checking the output are not timed.
+     */
+    static BenchmarkResult run_external_sorting(const BenchmarkConfig& config, const std::vector<int>& test_vector, PerfCounters& counters) {
+        std::filesystem::path directory = std::filesystem::temp_directory_path();
+        std::string input_path = (directory / "external_sort_input.bin").string();
+        std::string output_path = (directory / "external_sort_output.bin").string();
+
+        {
+            std::ofstream input(input_path, std::ios::binary);
+            input.write(reinterpret_cast<const char*>(test_vector.data()), test_vector.size() * sizeof(int));
+        }
+
+        ExternalMergeSort external_sorter(config.memory_budget, config.fan_in, directory);
+        AlgorithmResult external_result = measure_run(counters, [&] { return external_sorter.sortFileWithMetrics(input_path, output_path); });
+        const ExternalSortStats& stats = external_sorter.stats();
+
+        {
+            std::ifstream output(output_path, std::ios::binary);
+            std::vector<int> sorted(test_vector.size());
+            output.read(reinterpret_cast<char*>(sorted.data()), sorted.size() * sizeof(int));
+            if (output.gcount() != static_cast<std::streamsize>(sorted.size() * sizeof(int)) ||
+                !std::is_sorted(sorted.begin(), sorted.end())) {
+                throw std::runtime_error("External sort produced an unsorted or truncated output");
+            }
+        }
+        std::filesystem::remove(input_path);
+        std::filesystem::remove(output_path);
+
+        BenchmarkResult result = make_result(config, "External Merge Sort", external_result);
+        result.vector_comparisons = external_result.vector_comparisons;
+        result.bytes_read = stats.bytes_read;
+        result.bytes_written = stats.bytes_written;
+        result.passes = stats.passes;
+        double megabytes = static_cast<double>(test_vector.size() * sizeof(int)) / (1024.0 * 1024.0);
+        result.throughput_mb_s = megabytes / (external_result.execution_time / 1000.0);
+        return result;
+    }
+
+    /**
+     * Writes test_vector to a temporary binary file and answers two selections over it,
+     * reading it back chunk by chunk through FileChunkSource: the element of rank
+     * SELECTION_RANK through the bounded heap, and the median through one KLL sketch
+     * per chunk, merged into a total. Each answer is checked by an untimed counting pass
+     * over the file; a wrong exact answer, or a median more than STREAMING_EPSILON * n
+     * ranks off, throws std::runtime_error.
+     */
+    static void run_streaming_selection(const BenchmarkConfig& config, const std::vector<int>& test_vector, PerfCounters& counters,
+                                        std::vector<BenchmarkResult>& results) {
+        size_t n = test_vector.size();
+        if (n == 0) return;
+        std::string input_path = (std::filesystem::temp_directory_path() / "streaming_select_input.bin").string();
+        {
+            std::ofstream input(input_path, std::ios::binary);
+            input.write(reinterpret_cast<const char*>(test_vector.data()), n * sizeof(int));
+        }
+        double megabytes = static_cast<double>(n * sizeof(int)) / (1024.0 * 1024.0);
+
+        auto record = [&](const std::string& name, const AlgorithmResult& algorithm_result) {
+            BenchmarkResult result = make_result(config, name, algorithm_result);
+            result.bytes_read = n * sizeof(int);
+            result.passes = 1;
+            result.throughput_mb_s = megabytes / (algorithm_result.execution_time / 1000.0);
+            results.push_back(result);
+        };
+
+        size_t k = std::min(SELECTION_RANK, n - 1);
+        AlgorithmResult top_k = measure_run(counters, [&] {
+            FileChunkSource source(input_path);
+            return StreamingSelect::topKWithMetrics(source, k);
+        });
+        std::pair<size_t, size_t> ranks;
+        {
+            FileChunkSource check(input_path);
+            ranks = rank_interval(check, top_k.value);
+        }
+        if (ranks.first > k || ranks.second <= k) {
+            throw std::runtime_error("Streaming Top-K returned a key of rank " + std::to_string(ranks.first) + ", not " + std::to_string(k));
+        }
+        record("Streaming Top-K", top_k);
+
+        AlgorithmResult median = measure_run(counters, [&] {
+            FileChunkSource source(input_path);
+            return StreamingSelect::mergedQuantileWithMetrics(source, 0.5, STREAMING_EPSILON);
+        });
+        {
+            FileChunkSource check(input_path);
+            check_rank_error("Streaming KLL Median (merged)", n / 2, STREAMING_EPSILON * n, median.value,
+                             rank_interval(check, median.value));
+        }
+        record("Streaming KLL Median (merged)", median);
+
+        std::filesystem::remove(input_path);
+    }
+
+    // Sorters compared on records: a stable merge sort and the in-place quick sort
+    template <size_t PayloadBytes>
+    using MergeRecordSort = BasicRecordSort<BasicMergeSort, CountComparisons, PayloadBytes>;
+    template <size_t PayloadBytes>
+    using QuickRecordSort = BasicRecordSort<BasicQuickSort, CountComparisons, PayloadBytes>;
+
+    static BenchmarkResult make_result(const BenchmarkConfig& config, std::string name, const AlgorithmResult& algorithm_result) {
+        BenchmarkResult result;
+        result.algorithm_name = std::move(name);
+        result.test_case = config.test_case;
+        result.input_size = config.vector_size;
+        result.execution_time_ms = algorithm_result.execution_time;
+        result.comparisons = algorithm_result.comparisons;
+        result.memory_usage = algorithm_result.memory_usage;
+        result.swaps = algorithm_result.swaps;
+        result.hardware = algorithm_result.hardware;
+        result.memory = algorithm_result.memory;
+        return result;
+    }
+
+    // Throws unless permutation lists every index once, in key order
+    static void check_permutation(const std::string& name, const std::vector<int>& keys, const std::vector<size_t>& permutation) {
+        std::vector<bool> seen(keys.size(), false);
+        bool valid = permutation.size() == keys.size();
+        for (size_t i = 0; valid && i < permutation.size(); i++) {
+            valid = permutation[i] < keys.size() && !seen[permutation[i]] &&
+                    (i == 0 || keys[permutation[i - 1]] <= keys[permutation[i]]);
+            if (valid) seen[permutation[i]] = true;
         }
+        if (!valid) {
+            throw std::runtime_error(name + " returned a wrong permutation");
+        }
+    }
+
+    /**
+     * Argsort of the plain keys with both record sorters: the payload-independent
+     * part of every SoA record sort, reported once per iteration.
+     */
+    static void run_argsort(const BenchmarkConfig& config, const std::vector<int>& test_vector, PerfCounters& counters,
+                            std::vector<BenchmarkResult>& results) {
+        thread_local BasicArgsort<BasicMergeSort, CountComparisons> merge_argsort(MergeSortMode::BUFFERED);
+        thread_local BasicArgsort<BasicQuickSort, CountComparisons> quick_argsort(PartitionScheme::CLASSIC);
+        thread_local std::vector<size_t> permutation;
+
+        auto run = [&](auto& argsort, const std::string& name) {
+            AlgorithmResult algorithm_result = measure_run(counters, [&] { return argsort.argsortWithMetrics(test_vector, permutation); });
+            check_permutation(name, test_vector, permutation);
+            results.push_back(make_result(config, name, algorithm_result));
+        };
+        run(merge_argsort, "Merge Sort Argsort");
+        run(quick_argsort, "Quick Sort Argsort");
+    }
+
+    /**
+     * Sorts test_vector's keys carrying PayloadBytes-byte payloads, with each sorter
+     * in both layouts. Every payload starts with the record's input position, so the
+     * check also catches payloads that did not travel with their key. Building the
+     * records is not timed.
+     */
+    template <size_t PayloadBytes>
+    static void run_record_sorting(const BenchmarkConfig& config, const std::vector<int>& test_vector, PerfCounters& counters,
+                                   std::vector<BenchmarkResult>& results) {
+        static_assert(PayloadBytes >= sizeof(uint32_t), "the payload must hold the input position");
+        using Payload = RecordPayload<PayloadBytes>;
+        thread_local MergeRecordSort<PayloadBytes> merge_sorter(MergeSortMode::BUFFERED);
+        thread_local QuickRecordSort<PayloadBytes> quick_sorter(PartitionScheme::CLASSIC);
+        thread_local std::vector<Record<PayloadBytes>> records;
+        thread_local std::vector<int> keys;
+        thread_local std::vector<Payload> payloads;
+
+        size_t n = test_vector.size();
+        auto make_payload = [](size_t position) {
+            Payload payload;
+            payload.fill(static_cast<unsigned char>(position));
+            uint32_t tag = static_cast<uint32_t>(position);
+            std::memcpy(payload.data(), &tag, sizeof(tag));
+            return payload;
+        };
+        auto check = [&](const std::string& name, auto key_at, auto payload_at) {
+            for (size_t i = 0; i < n; i++) {
+                uint32_t position;
+                std::memcpy(&position, payload_at(i).data(), sizeof(position));
+                if ((i > 0 && key_at(i - 1) > key_at(i)) || position >= n || test_vector[position] != key_at(i)) {
+                    throw std::runtime_error(name + " left its records unsorted or separated from their payloads");
+                }
+            }
+        };
+        std::string suffix = " " + std::to_string(PayloadBytes) + "B";
+
+        auto run_aos = [&](auto& sorter, const std::string& name) {
+            records.resize(n);
+            for (size_t i = 0; i < n; i++) records[i] = {test_vector[i], make_payload(i)};
+            AlgorithmResult algorithm_result = measure_run(counters, [&] { return sorter.sortRecordsWithMetrics(records); });
+            check(name, [&](size_t i) { return records[i].key; }, [&](size_t i) -> const Payload& { return records[i].payload; });
+            results.push_back(make_result(config, name + suffix, algorithm_result));
+            results.back().payload_bytes = PayloadBytes;
+        };
+        auto run_soa = [&](auto& sorter, const std::string& name) {
+            keys.assign(test_vector.begin(), test_vector.end());
+            payloads.resize(n);
+            for (size_t i = 0; i < n; i++) payloads[i] = make_payload(i);
+            AlgorithmResult algorithm_result = measure_run(counters, [&] { return sorter.sortColumnsWithMetrics(keys, payloads); });
+            check(name, [&](size_t i) { return keys[i]; }, [&](size_t i) -> const Payload& { return payloads[i]; });
+            results.push_back(make_result(config, name + suffix, algorithm_result));
+            results.back().payload_bytes = PayloadBytes;
+        };
+        run_aos(merge_sorter, "Merge Sort AoS");
+        run_soa(merge_sorter, "Merge Sort SoA");
+        run_aos(quick_sorter, "Quick Sort AoS");
+        run_soa(quick_sorter, "Quick Sort SoA");
+    }
+
+    // Order-independent fingerprint of a key multiset: a sort must preserve it
+    static uint64_t multiset_fingerprint(Span<const LargeKey> keys) {
+        uint64_t sum = 0;
+        for (LargeKey key : keys) {
+            sum += SplitMix64(static_cast<uint64_t>(key)).next();
+        }
+        return sum;
+    }
+
+    /**
+     * Large-scale tier: sorts and selects 64-bit keys with size_t-indexed engines at
+     * sizes past 2^31 elements, checks every answer and reports throughput in MB/s of
+     * keys. The sorts are checked for order and for an unchanged key multiset, the
+     * median by counting ranks over the input; both checks are single O(n) passes that
+     * need no second copy of the data. Holds the input, one working copy and the
+     * scratch buffers of the two merge sorts: up to 28 bytes per element.
+     *
+     * Every engine templated on its element type runs here except SelectLinear, whose
+     * partitions copy the input several times over; the others only sort or select int.
+     */
+    static void run_large_scale(const BenchmarkConfig& config, PerfCounters& counters, std::vector<BenchmarkResult>& results) {
+        thread_local BasicMergeSort<CountComparisons, LargeKey> merge_sorter(MergeSortMode::BOTTOM_UP);
+        thread_local BasicQuickSort<CountComparisons, LargeKey> quick_sorter(PartitionScheme::BLOCK);
+        thread_local BasicIntroSort<CountComparisons, LargeKey> intro_sorter;
+        thread_local BasicNaturalMergeSort<CountComparisons, LargeKey> natural_merge_sorter;
+        thread_local BasicQuickSelect<CountComparisons, LargeKey> quick_selector(PartitionScheme::BLOCK);
+        thread_local std::vector<LargeKey> work;
+
+        BasicInputCache<LargeKey>::Input input = generate_large_input(config);
+        const std::vector<LargeKey>& keys = *input;
+        size_t n = keys.size();
+        if (n == 0) return;
+        uint64_t fingerprint = multiset_fingerprint(keys);
+        double megabytes = static_cast<double>(n * sizeof(LargeKey)) / (1024.0 * 1024.0);
+
+        auto record = [&](const std::string& name, const AlgorithmResult& algorithm_result) {
+            BenchmarkResult result = make_result(config, name, algorithm_result);
+            result.throughput_mb_s = megabytes / (algorithm_result.execution_time / 1000.0);
+            results.push_back(result);
+        };
+        auto run_sort = [&](auto& sorter, const std::string& name) {
+            work.assign(keys.begin(), keys.end());
+            AlgorithmResult algorithm_result = measure_run(counters, [&] { return sorter.sortWithMetrics(work); });
+            if (!std::is_sorted(work.begin(), work.end()) || multiset_fingerprint(work) != fingerprint) {
+                throw std::runtime_error(name + " did not sort its " + std::to_string(n) + " keys");
+            }
+            record(name, algorithm_result);
+        };
+        run_sort(merge_sorter, "Merge Sort Bottom-Up");
+        run_sort(quick_sorter, "Quick Sort Block");
+        run_sort(intro_sorter, "Intro Sort");
+        run_sort(natural_merge_sorter, "Natural Merge Sort");
+
+        size_t k = n / 2;
+        work.assign(keys.begin(), keys.end());
+        AlgorithmResult algorithm_result = measure_run(counters, [&] { return quick_selector.quickSelectWithMetrics(work, k); });
+        LargeKey median = work[k];
+        size_t below = 0, not_above = 0;
+        for (LargeKey key : keys) {
+            below += key < median;
+            not_above += key <= median;
+        }
+        if (below > k || not_above <= k) {
+            throw std::runtime_error("QuickSelect Block returned a key of rank " + std::to_string(below) + ", not " + std::to_string(k));
+        }
+        record("QuickSelect Block", algorithm_result);
+    }
+
+    // 0-based rank every SELECTS engine looks for (the 7th smallest element)
+    static constexpr size_t SELECTION_RANK = 6;
+
+    // Rank error allowed to the sketch of the streaming selection tier, as a fraction of n
+    static constexpr double STREAMING_EPSILON = 0.01;
+
+    // Ranks [below, not_above) value occupies in the stream, counted in one pass over source
+    static std::pair<size_t, size_t> rank_interval(ChunkSource& source, int value) {
+        std::vector<int> chunk(StreamingSelect::CHUNK_SIZE);
+        size_t below = 0, not_above = 0;
+        size_t read_count;
+        while ((read_count = source.read(chunk.data(), chunk.size())) > 0) {
+            for (size_t i = 0; i < read_count; i++) {
+                below += chunk[i] < value;
+                not_above += chunk[i] <= value;
+            }
+        }
+        return {below, not_above};
+    }
+
+    /**
+     * Throws when an approximate answer with ranks [below, not_above) lies more than
+     * max_error ranks from target.
+     */
+    static void check_rank_error(const std::string& name, size_t target, double max_error, int value,
+                                 std::pair<size_t, size_t> ranks) {
+        size_t below = ranks.first, not_above = ranks.second;
+        size_t rank_error = target < below ? below - target
+                          : target >= not_above ? target - not_above + 1 : 0;
+        if (rank_error > max_error) {
+            throw std::runtime_error(name + " answered " + std::to_string(value) + ", " + std::to_string(rank_error) +
+                                     " ranks off rank " + std::to_string(target));
+        }
+    }
+
+    // Throws unless a SELECTS_MANY engine returned the exact element of every rank in ks
+    static void check_values(const std::string& name, const std::vector<size_t>& ks, const std::vector<int>& values,
+                             const std::vector<int>& exact) {
+        if (values.size() != exact.size()) {
+            throw std::runtime_error(name + " returned " + std::to_string(values.size()) + " values for " +
+                                     std::to_string(exact.size()) + " ranks");
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            if (values[i] != exact[i]) {
+                throw std::runtime_error(name + " returned " + std::to_string(values[i]) + " for rank " + std::to_string(ks[i]) +
+                                         ", the exact answer is " + std::to_string(exact[i]));
+            }
+        }
+    }
+
+    // rank_count ranks spread evenly over [0, size), in increasing order
+    static std::vector<size_t> generate_ranks(size_t size, size_t rank_count) {
+        std::vector<size_t> ks;
+        for (size_t i = 0; i < rank_count; i++) {
+            ks.push_back((i + 1) * size / (rank_count + 1));
+        }
+        return ks;
+    }
+
+    /**
+     * Runner of the engine for this benchmark thread, thread count and placement,
+     * created on first use. Engines live for the whole run so thread start-up and
+     * scratch allocation stay out of the measured time; one engine per placement
+     * keeps every scratch buffer allocated with its own placement.
+     */
+    static AlgorithmRunner& get_runner(const AlgorithmEntry& entry, size_t threads, MemoryPlacement placement) {
+        thread_local std::map<std::tuple<std::string, size_t, MemoryPlacement>, AlgorithmRunner> runners;
+
+        auto key = std::make_tuple(entry.id, threads, placement);
+        auto it = runners.find(key);
+        if (it == runners.end()) {
+            // Pool workers inherit the creating thread's affinity; give them every
+            // core even when the harness has pinned the benchmark thread
+            std::unique_ptr<CpuAffinity::Unpinned> unpinned;
+            if (entry.has(PARALLEL)) unpinned = std::make_unique<CpuAffinity::Unpinned>();
+            it = runners.emplace(key, entry.make(threads)).first;
+        }
+        return it->second;
+    }
+
+    // Upper bound on the memory held by cached inputs
+    static constexpr size_t INPUT_CACHE_BYTES = size_t(1) << 30;
+    // Skew of the Zipf input: P(k) ~ 1 / k^ZIPF_EXPONENT
+    static constexpr double ZIPF_EXPONENT = 1.0;
+    static constexpr size_t SAWTOOTH_TEETH = 16;
+    // Length of each ascending run of the sorted-runs input; divides InputGenerator::BLOCK_SIZE so
+    // every run is generated by one block
+    static constexpr size_t SORTED_RUN_LENGTH = 4096;
+
+    // value as a Key, saturating at the largest Key so positions past its range never wrap
+    template <typename Key>
+    static Key clamp_key(uint64_t value) {
+        return static_cast<Key>(std::min<uint64_t>(value, static_cast<uint64_t>(std::numeric_limits<Key>::max())));
+    }
+
+    // Keys of the requested shape; int for the regular tiers, int64_t for the large-scale tier
+    template <typename Key>
+    static std::vector<Key> generate_keys(TestCaseType test_case, size_t size, uint64_t seed) {
+        switch (test_case) {
+            case TestCaseType::RANDOM: return generate_random_vector<Key>(size, seed);
+            case TestCaseType::NEARLY_SORTED: return generate_nearly_sorted_vector<Key>(size, seed);
+            case TestCaseType::REVERSE_SORTED: return generate_reverse_sorted_vector<Key>(size);
+            case TestCaseType::FEW_UNIQUE: return generate_few_unique_vector<Key>(size, seed);
+            case TestCaseType::ZIPF: return generate_zipf_vector<Key>(size, seed);
+            case TestCaseType::ORGAN_PIPE: return generate_organ_pipe_vector<Key>(size);
+            case TestCaseType::SAWTOOTH: return generate_sawtooth_vector<Key>(size);
+            case TestCaseType::SORTED_RUNS: return generate_sorted_runs_vector<Key>(size, seed);
+            case TestCaseType::ALL_EQUAL: return std::vector<Key>(size, 1);
+        }
+        throw std::invalid_argument("Unknown test case");
+    }
+
+    // Keys drawn from [1, 10 * size], capped at the largest Key
+    template <typename Key>
+    static std::vector<Key> generate_random_vector(size_t size, uint64_t seed) {
+        std::vector<Key> vec(size);
+        uint64_t range = std::min<uint64_t>(static_cast<uint64_t>(size) * 10, static_cast<uint64_t>(std::numeric_limits<Key>::max()));
+        InputGenerator::forEachBlock(size, seed, [&](size_t begin, size_t end, Xoshiro256& gen) {
+            for (size_t i = begin; i < end; i++) {
+                vec[i] = static_cast<Key>(1 + gen.below(range));
+            }
+        });
         return vec;
     }
     
-    static std::vector<int> generate_nearly_sorted_vector(size_t size) {
-        std::vector<int> vec(size);
-        for (size_t i = 0; i < size; ++i) {
-            vec[i] = static_cast<int>(i + 1);
-        }
+    template <typename Key>
+    static std::vector<Key> generate_nearly_sorted_vector(size_t size, uint64_t seed) {
+        std::vector<Key> vec = generate_ascending_vector<Key>(size);
         
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        // The swaps pair positions across the whole vector, so they stay sequential
+        Xoshiro256 gen(seed);
         size_t num_shuffles = size / 20;
         
         for (size_t i = 0; i < num_shuffles; ++i) {
-            std::uniform_int_distribution<size_t> distrib(0, size - 1);
-            size_t idx1 = distrib(gen);
-            size_t idx2 = distrib(gen);
+            size_t idx1 = gen.below(size);
+            size_t idx2 = gen.below(size);
             std::swap(vec[idx1], vec[idx2]);
         }
         
         return vec;
     }
+
+    template <typename Key>
+    static std::vector<Key> generate_ascending_vector(size_t size) {
+        std::vector<Key> vec(size);
+        InputGenerator::forEachBlock(size, 0, [&](size_t begin, size_t end, Xoshiro256&) {
+            for (size_t i = begin; i < end; ++i) {
+                vec[i] = clamp_key<Key>(i + 1);
+            }
+        });
+        return vec;
+    }
     
-    static std::vector<int> generate_reverse_sorted_vector(size_t size) {
-        std::vector<int> vec(size);
-        for (size_t i = 0; i < size; ++i) {
-            vec[i] = static_cast<int>(size - i);
-        }
+    template <typename Key>
+    static std::vector<Key> generate_reverse_sorted_vector(size_t size) {
+        std::vector<Key> vec(size);
+        InputGenerator::forEachBlock(size, 0, [&](size_t begin, size_t end, Xoshiro256&) {
+            for (size_t i = begin; i < end; ++i) {
+                vec[i] = clamp_key<Key>(size - i);
+            }
+        });
+        return vec;
+    }
+    
+    // Only a handful of distinct keys, the duplicate-heavy shape 3-way partitioning targets
+    template <typename Key>
+    static std::vector<Key> generate_few_unique_vector(size_t size, uint64_t seed) {
+        std::vector<Key> vec(size);
+        InputGenerator::forEachBlock(size, seed, [&](size_t begin, size_t end, Xoshiro256& gen) {
+            for (size_t i = begin; i < end; i++) {
+                vec[i] = static_cast<Key>(1 + gen.below(10));
+            }
+        });
+        return vec;
+    }
+
+    // Keys 1..size drawn with Zipf-skewed frequencies: a few hot keys and a long tail
+    template <typename Key>
+    static std::vector<Key> generate_zipf_vector(size_t size, uint64_t seed) {
+        std::vector<Key> vec(size);
+        ZipfSampler zipf(size, ZIPF_EXPONENT);
+        InputGenerator::forEachBlock(size, seed, [&](size_t begin, size_t end, Xoshiro256& gen) {
+            for (size_t i = begin; i < end; i++) {
+                vec[i] = clamp_key<Key>(zipf(gen));
+            }
+        });
+        return vec;
+    }
+
+    // Ascending to the middle, then descending: 1, 2, ..., n/2, ..., 2, 1
+    template <typename Key>
+    static std::vector<Key> generate_organ_pipe_vector(size_t size) {
+        std::vector<Key> vec(size);
+        InputGenerator::forEachBlock(size, 0, [&](size_t begin, size_t end, Xoshiro256&) {
+            for (size_t i = begin; i < end; ++i) {
+                vec[i] = clamp_key<Key>(std::min(i, size - 1 - i) + 1);
+            }
+        });
+        return vec;
+    }
+
+    // SAWTOOTH_TEETH ascending ramps over the same key range
+    template <typename Key>
+    static std::vector<Key> generate_sawtooth_vector(size_t size) {
+        std::vector<Key> vec(size);
+        size_t period = std::max<size_t>(1, size / SAWTOOTH_TEETH);
+        InputGenerator::forEachBlock(size, 0, [&](size_t begin, size_t end, Xoshiro256&) {
+            for (size_t i = begin; i < end; ++i) {
+                vec[i] = clamp_key<Key>(i % period + 1);
+            }
+        });
+        return vec;
+    }
+
+    // Random keys, sorted within consecutive runs of SORTED_RUN_LENGTH elements
+    template <typename Key>
+    static std::vector<Key> generate_sorted_runs_vector(size_t size, uint64_t seed) {
+        std::vector<Key> vec = generate_random_vector<Key>(size, seed);
+        InputGenerator::forEachBlock(size, 0, [&](size_t begin, size_t end, Xoshiro256&) {
+            for (size_t run = begin; run < end; run += SORTED_RUN_LENGTH) {
+                std::sort(vec.begin() + run, vec.begin() + std::min(end, run + SORTED_RUN_LENGTH));
+            }
+        });
         return vec;
     }
 };
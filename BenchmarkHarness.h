@@ -0,0 +1,222 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "CpuAffinity.h"
+#include "ResultSink.h"
+
+struct HarnessOptions {
+    // Core the benchmark thread is pinned to, -1 to leave it unpinned
+    int pin_cpu = 0;
+    // Iterations run and discarded before sampling (page faults, caches, branch predictors, pools)
+    size_t warmup_iterations = 3;
+    // Repetitions are added until every algorithm's mean is known to target_relative_error,
+    // but never fewer than min_repetitions nor more than max_repetitions
+    size_t min_repetitions = 10;
+    size_t max_repetitions = 1000;
+    double target_relative_error = 0.01;
+    double confidence = 0.95;
+    size_t bootstrap_resamples = 2000;
+    uint64_t bootstrap_seed = 42;
+    // Keep every sampled iteration: buffered in a ResultSink and appended to the
+    // configuration's *_benchmark.csv (and *_benchmark.bin with columnar_output)
+    // once the configuration is done, or by a background writer thread
+    bool write_raw_samples = true;
+    bool columnar_output = true;
+    bool background_writer = false;
+    // Flush every this many rows instead of once per configuration (0), mostly
+    // useful with the background writer on long configurations
+    size_t flush_every = 0;
+};
+
+/**
+ * Summary of the execution times of one algorithm in one configuration
+ */
+struct SampleStatistics {
+    size_t count = 0;
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double ci_low = 0.0;   // percentile bootstrap confidence interval of the mean
+    double ci_high = 0.0;
+
+    // Linear interpolation between the closest ranks of sorted samples, p in [0, 1]
+    static double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        double position = p * (sorted.size() - 1);
+        size_t lower = static_cast<size_t>(position);
+        size_t upper = std::min(lower + 1, sorted.size() - 1);
+        return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+    }
+
+    static SampleStatistics compute(std::vector<double> samples, double confidence, size_t resamples, uint64_t seed) {
+        SampleStatistics stats;
+        stats.count = samples.size();
+        if (samples.empty()) return stats;
+
+        std::sort(samples.begin(), samples.end());
+        stats.min = samples.front();
+        stats.median = percentile(samples, 0.5);
+        stats.p95 = percentile(samples, 0.95);
+        stats.p99 = percentile(samples, 0.99);
+
+        double sum = 0.0;
+        for (double sample : samples) sum += sample;
+        stats.mean = sum / samples.size();
+        double squares = 0.0;
+        for (double sample : samples) squares += (sample - stats.mean) * (sample - stats.mean);
+        stats.stddev = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+
+        // Fixed seed so the same samples always give the same interval
+        std::mt19937_64 gen(seed);
+        std::uniform_int_distribution<size_t> pick(0, samples.size() - 1);
+        std::vector<double> means(resamples);
+        for (double& resampled_mean : means) {
+            double resampled_sum = 0.0;
+            for (size_t i = 0; i < samples.size(); i++) resampled_sum += samples[pick(gen)];
+            resampled_mean = resampled_sum / samples.size();
+        }
+        std::sort(means.begin(), means.end());
+        stats.ci_low = percentile(means, (1.0 - confidence) / 2.0);
+        stats.ci_high = percentile(means, (1.0 + confidence) / 2.0);
+        return stats;
+    }
+};
+
+/**
+ * @class BenchmarkHarness
+ * @brief Repeats Benchmark::run_iteration on one fixed input per configuration until
+ * the timings are statistically stable, then writes a per-algorithm summary.
+ *
+ * The thread is pinned, warmed up, and sampled until the normal-approximation
+ * confidence interval of every algorithm's mean time is within the target relative
+ * error. Times come from the algorithms' own std::chrono::steady_clock timers (the
+ * vDSO reads the TSC on x86 Linux). The summary goes to
+ * <type>_<case>_<size>k_statistics.csv, one row per algorithm.
+ */
+class BenchmarkHarness {
+public:
+    static void run(const BenchmarkConfig& config, const HarnessOptions& options) {
+        if (options.pin_cpu >= 0 && !CpuAffinity::pinCurrentThread(options.pin_cpu)) {
+            std::cerr << "Warning: could not pin to core " << options.pin_cpu << ", running unpinned\n";
+        }
+
+        // The same input for every repetition, so the spread reflects the machine, not the data
+        InputCache::Input input = Benchmark::generate_input(config);
+        const std::vector<int>& test_vector = *input;
+        for (size_t i = 0; i < options.warmup_iterations; i++) {
+            Benchmark::run_iteration(config, test_vector);
+        }
+
+        std::string raw_filename = Benchmark::generate_filename(config);
+        std::unique_ptr<ResultSink> sink;
+        if (options.write_raw_samples) {
+            sink = std::make_unique<ResultSink>(raw_filename,
+                                                options.columnar_output ? Benchmark::columnar_filename(raw_filename) : "",
+                                                options.flush_every > 0 ? options.flush_every : options.max_repetitions,
+                                                options.background_writer);
+        }
+        std::vector<std::string> names;
+        std::vector<std::vector<double>> samples;
+        double z = normalQuantile((1.0 + options.confidence) / 2.0);
+        double relative_error = 0.0;
+
+        size_t repetitions = 0;
+        while (repetitions < options.max_repetitions) {
+            std::vector<Benchmark::BenchmarkResult> results = Benchmark::run_iteration(config, test_vector);
+            if (names.empty()) {
+                for (const auto& result : results) names.push_back(result.algorithm_name);
+                samples.resize(results.size());
+            }
+            for (size_t i = 0; i < results.size(); i++) {
+                samples[i].push_back(results[i].execution_time_ms);
+            }
+            if (sink) {
+                Benchmark::append_results(*sink, results, config.algorithm_type, repetitions);
+                if (options.flush_every > 0 && sink->bufferedRows() >= options.flush_every) {
+                    sink->flush();
+                }
+            }
+            repetitions++;
+
+            relative_error = 0.0;
+            for (const auto& algorithm_samples : samples) {
+                relative_error = std::max(relative_error, relativeError(algorithm_samples, z));
+            }
+            if (repetitions >= options.min_repetitions && relative_error <= options.target_relative_error) {
+                break;
+            }
+        }
+
+        if (sink) {
+            sink->flush();
+        }
+
+        std::cout << "[" << config.test_name << "] " << repetitions << " repetitions, worst relative error "
+                  << relative_error * 100.0 << "%\n";
+
+        std::vector<SampleStatistics> statistics;
+        for (const auto& algorithm_samples : samples) {
+            statistics.push_back(SampleStatistics::compute(algorithm_samples, options.confidence,
+                                                           options.bootstrap_resamples, options.bootstrap_seed));
+        }
+        save_statistics_to_csv(config, names, statistics, statisticsFilename(raw_filename));
+    }
+
+private:
+    // Half-width of the confidence interval of the mean relative to the mean
+    static double relativeError(const std::vector<double>& samples, double z) {
+        if (samples.size() < 2) return INFINITY;
+        double mean = 0.0;
+        for (double sample : samples) mean += sample;
+        mean /= samples.size();
+        double squares = 0.0;
+        for (double sample : samples) squares += (sample - mean) * (sample - mean);
+        double stddev = std::sqrt(squares / (samples.size() - 1));
+        return mean > 0.0 ? z * stddev / std::sqrt(static_cast<double>(samples.size())) / mean : 0.0;
+    }
+
+    // Inverse of the standard normal CDF (Abramowitz and Stegun 26.2.23, error < 4.5e-4)
+    static double normalQuantile(double p) {
+        double q = p < 0.5 ? p : 1.0 - p;
+        double t = std::sqrt(-2.0 * std::log(q));
+        double x = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+                       (1.0 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+        return p < 0.5 ? -x : x;
+    }
+
+    static std::string statisticsFilename(const std::string& raw_filename) {
+        const std::string suffix = "_benchmark.csv";
+        return raw_filename.substr(0, raw_filename.size() - suffix.size()) + "_statistics.csv";
+    }
+
+    static void save_statistics_to_csv(const BenchmarkConfig& config, const std::vector<std::string>& names,
+                                       const std::vector<SampleStatistics>& statistics, const std::string& filename) {
+        std::ofstream outfile(filename, std::ios::app);
+        if (outfile.tellp() == 0) {
+            outfile << "Test Case,Input Size,Algorithm,Repetitions,Min (ms),Median (ms),Mean (ms),Stddev (ms),"
+                    << "P95 (ms),P99 (ms),CI Low (ms),CI High (ms)\n";
+        }
+        for (size_t i = 0; i < names.size(); i++) {
+            const SampleStatistics& stats = statistics[i];
+            outfile << Benchmark::get_test_case_name(config.test_case) << "," << config.vector_size << ","
+                    << names[i] << "," << stats.count << "," << stats.min << "," << stats.median << ","
+                    << stats.mean << "," << stats.stddev << "," << stats.p95 << "," << stats.p99 << ","
+                    << stats.ci_low << "," << stats.ci_high << "\n";
+        }
+    }
+};
+
+#endif // BENCHMARK_HARNESS_H
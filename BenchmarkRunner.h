@@ -0,0 +1,475 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "BenchmarkHarness.h"
+#include "CpuAffinity.h"
+#include "MemoryTracker.h"
+#include "PageAllocator.h"
+
+struct RunnerSettings {
+    HarnessOptions harness;
+    // Configurations run at once, each on its own pinned core; 0 for one per available core
+    size_t workers = 0;
+    // Base seed every configuration's input seed is derived from, 0 for unseeded inputs
+    uint64_t seed = 1;
+};
+
+/**
+ * @class BenchmarkRunner
+ * @brief Reads benchmark configurations from files or the command line and runs them
+ * concurrently, one configuration per pinned core, longest first.
+ *
+ * A suite is written as an algorithm type followed by key=value options, one suite per
+ * line in a file or one per type word on the command line. Each suite expands to one
+ * configuration per (size, case) pair. Settings apply to the whole run:
+ *
+ *   # type            suite options
+ *   sorting           sizes=100000,500000,1000000 cases=random,nearly_sorted threads=1,2,4
+ *   sorting           sizes=1M algorithms=quick_sort,merge_sort_buffered,radix_sort
+ *   selection         sizes=1000000 cases=random ranks=1,4,16
+ *   selection         sizes=100M threads=1,2,4,8
+ *   external_sorting  sizes=8M memory=16Mi fan_in=16
+ *   record_sorting    sizes=1M payloads=4,16,64
+ *   sorting           sizes=10M placements=default,thp,local,interleave
+ *   large_scale       sizes=1G,4G
+ *   streaming_selection sizes=100M
+ *   # settings
+ *   warmup=3 repetitions=10:1000 target_error=0.01 workers=0 seed=1
+ *
+ * Suite keys: sizes (required), cases (default random), algorithms (default every
+ * registered engine for the type, see AlgorithmRegistry), threads, ranks, memory, fan_in,
+ * payloads (record payload bytes, any of 4, 8, 16, 32, 64; default all of them),
+ * placements (memory placement of the engines' buffers, any of default, thp, hugetlb,
+ * local, interleave; see PageAllocator.h).
+ * Cases: random, nearly_sorted, reverse_sorted, few_unique, zipf, organ_pipe, sawtooth,
+ * sorted_runs, all_equal.
+ * Numbers take K/M/G (decimal) or Ki/Mi/Gi (binary) suffixes.
+ * Setting keys: warmup, repetitions (min:max or a fixed count), target_error, confidence,
+ * workers, seed, pin (0 to leave threads unpinned), raw_samples, columnar,
+ * background_writer, flush_every. Settings apply to every suite of the run and the
+ * last occurrence wins, so suites that need fewer repetitions (large_scale) run on
+ * their own.
+ *
+ * Configurations that use several cores themselves (threads=...), the disk
+ * (external_sorting, streaming_selection) or most of the memory (large_scale) would disturb their
+ * neighbours, so they run one at a time after the concurrent ones. Configurations that write the same output file run back to back
+ * on one worker. Every configuration gets an input seed derived from the base seed, its
+ * case and its size, so reruns measure the same inputs regardless of scheduling, and
+ * sorting and selection suites over the same (case, size) share one cached input.
+ */
+class BenchmarkRunner {
+public:
+    struct Plan {
+        std::vector<BenchmarkConfig> configs;
+        RunnerSettings settings;
+        bool pin = true;
+    };
+
+    // Arguments are config files, suite type words and key=value options
+    static Plan parseArguments(const std::vector<std::string>& arguments) {
+        Plan plan;
+        Suite suite;
+        for (const std::string& argument : arguments) {
+            if (argument.find('=') == std::string::npos && !isAlgorithmType(argument)) {
+                finishSuite(suite, plan);
+                parseFile(argument, plan);
+            } else {
+                parseToken(argument, suite, plan);
+            }
+        }
+        finishSuite(suite, plan);
+        return plan;
+    }
+
+    static void parseFile(const std::string& path, Plan& plan) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::invalid_argument("cannot open configuration file " + path);
+        }
+        std::string line;
+        size_t line_number = 0;
+        while (std::getline(file, line)) {
+            line_number++;
+            line = line.substr(0, line.find('#'));
+            std::istringstream tokens(line);
+            std::string token;
+            Suite suite;
+            try {
+                while (tokens >> token) {
+                    parseToken(token, suite, plan);
+                }
+                finishSuite(suite, plan);
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument(path + ":" + std::to_string(line_number) + ": " + e.what());
+            }
+        }
+    }
+
+    /**
+     * @brief Runs every configuration of the plan.
+     * @return false when at least one configuration failed
+     */
+    static bool run(const Plan& plan) {
+        std::vector<Job> concurrent_jobs;
+        std::vector<Job> exclusive_jobs;
+        for (Job& job : makeJobs(plan)) {
+            (job.exclusive ? exclusive_jobs : concurrent_jobs).push_back(std::move(job));
+        }
+        // Longest first keeps the last, straggling job short
+        std::stable_sort(concurrent_jobs.begin(), concurrent_jobs.end(),
+                         [](const Job& a, const Job& b) { return a.cost > b.cost; });
+
+        size_t workers = plan.settings.workers > 0 ? plan.settings.workers
+                                                   : static_cast<size_t>(CpuAffinity::availableCores());
+        workers = std::max<size_t>(1, std::min(workers, concurrent_jobs.size()));
+
+        std::cout << "Running " << plan.configs.size() << " configurations: " << concurrent_jobs.size()
+                  << " jobs on " << workers << " workers, then " << exclusive_jobs.size() << " exclusive jobs\n";
+
+        std::atomic<bool> failed{false};
+        std::atomic<size_t> next_job{0};
+        std::mutex output_mutex;
+        auto run_job = [&](const Job& job, int cpu) {
+            HarnessOptions options = plan.settings.harness;
+            options.pin_cpu = plan.pin ? cpu : -1;
+            for (const BenchmarkConfig& config : job.configs) {
+                {
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << "=== Starting benchmark: " << config.test_name << " ===\n";
+                }
+                try {
+                    BenchmarkHarness::run(config, options);
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cerr << "Error in " << config.test_name << ": " << e.what() << "\n";
+                    failed = true;
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << "=== Completed benchmark: " << config.test_name << " ===\n";
+            }
+        };
+
+        MemoryTracker::setConcurrentRuns(workers > 1);
+        std::vector<std::thread> threads;
+        for (size_t worker = 0; worker < workers; worker++) {
+            threads.emplace_back([&, worker] {
+                for (size_t index = next_job++; index < concurrent_jobs.size(); index = next_job++) {
+                    run_job(concurrent_jobs[index], static_cast<int>(worker));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        MemoryTracker::setConcurrentRuns(false);
+        for (const Job& job : exclusive_jobs) {
+            // Run on a fresh thread so the pinning does not stick to the caller
+            std::thread([&] { run_job(job, 0); }).join();
+        }
+        return !failed;
+    }
+
+private:
+    struct Suite {
+        bool active = false;
+        AlgorithmType type = AlgorithmType::SORTING;
+        std::vector<size_t> sizes;
+        std::vector<TestCaseType> cases;
+        std::vector<std::string> algorithms;
+        std::vector<size_t> threads;
+        std::vector<size_t> ranks;
+        size_t memory_budget = 0;
+        size_t fan_in = 16;
+        std::vector<size_t> payloads;
+        std::vector<MemoryPlacement> placements;
+    };
+
+    struct Job {
+        std::vector<BenchmarkConfig> configs;
+        double cost = 0.0;
+        bool exclusive = false;
+    };
+
+    static bool isAlgorithmType(const std::string& word) {
+        return word == "sorting" || word == "selection" || word == "external_sorting" || word == "record_sorting" ||
+               word == "large_scale" || word == "streaming_selection";
+    }
+
+    static void parseToken(const std::string& token, Suite& suite, Plan& plan) {
+        if (isAlgorithmType(token)) {
+            finishSuite(suite, plan);
+            suite = Suite();
+            suite.active = true;
+            suite.type = token == "sorting" ? AlgorithmType::SORTING
+                       : token == "selection" ? AlgorithmType::SELECTION
+                       : token == "external_sorting" ? AlgorithmType::EXTERNAL_SORTING
+                       : token == "record_sorting" ? AlgorithmType::RECORD_SORTING
+                       : token == "large_scale" ? AlgorithmType::LARGE_SCALE : AlgorithmType::STREAMING_SELECTION;
+            return;
+        }
+
+        size_t equals = token.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument("expected an algorithm type or key=value, got '" + token + "'");
+        }
+        std::string key = token.substr(0, equals);
+        std::string value = token.substr(equals + 1);
+        if (parseSetting(key, value, plan)) {
+            return;
+        }
+        if (!suite.active) {
+            throw std::invalid_argument("'" + key + "' must follow an algorithm type");
+        }
+        if (key == "sizes") {
+            suite.sizes = parseSizes(value);
+        } else if (key == "cases") {
+            suite.cases.clear();
+            for (const std::string& name : split(value)) suite.cases.push_back(parseTestCase(name));
+        } else if (key == "algorithms") {
+            suite.algorithms = split(value);
+        } else if (key == "threads") {
+            suite.threads = parseSizes(value);
+        } else if (key == "ranks") {
+            suite.ranks = parseSizes(value);
+        } else if (key == "memory") {
+            suite.memory_budget = parseSize(value);
+        } else if (key == "fan_in") {
+            suite.fan_in = parseSize(value);
+        } else if (key == "payloads") {
+            suite.payloads = parseSizes(value);
+        } else if (key == "placements") {
+            suite.placements.clear();
+            for (const std::string& name : split(value)) suite.placements.push_back(PageAllocator::parse(name));
+        } else {
+            throw std::invalid_argument("unknown option '" + key + "'");
+        }
+    }
+
+    // Applies a run-wide setting, false when key is not one
+    static bool parseSetting(const std::string& key, const std::string& value, Plan& plan) {
+        HarnessOptions& harness = plan.settings.harness;
+        if (key == "warmup") {
+            harness.warmup_iterations = parseSize(value);
+        } else if (key == "repetitions") {
+            size_t colon = value.find(':');
+            harness.min_repetitions = parseSize(value.substr(0, colon));
+            harness.max_repetitions = colon == std::string::npos ? harness.min_repetitions
+                                                                 : parseSize(value.substr(colon + 1));
+            if (harness.min_repetitions == 0 || harness.max_repetitions < harness.min_repetitions) {
+                throw std::invalid_argument("repetitions must be N or MIN:MAX with 0 < MIN <= MAX");
+            }
+        } else if (key == "target_error") {
+            harness.target_relative_error = parseDouble(value);
+        } else if (key == "confidence") {
+            harness.confidence = parseDouble(value);
+        } else if (key == "workers") {
+            plan.settings.workers = parseSize(value);
+        } else if (key == "seed") {
+            plan.settings.seed = parseSize(value);
+        } else if (key == "pin") {
+            plan.pin = parseSize(value) != 0;
+        } else if (key == "raw_samples") {
+            harness.write_raw_samples = parseSize(value) != 0;
+        } else if (key == "columnar") {
+            harness.columnar_output = parseSize(value) != 0;
+        } else if (key == "background_writer") {
+            harness.background_writer = parseSize(value) != 0;
+        } else if (key == "flush_every") {
+            harness.flush_every = parseSize(value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    static void finishSuite(Suite& suite, Plan& plan) {
+        if (!suite.active) return;
+        suite.active = false;
+        if (suite.sizes.empty()) {
+            throw std::invalid_argument("suite without sizes=");
+        }
+        if (suite.type == AlgorithmType::EXTERNAL_SORTING && suite.memory_budget == 0) {
+            throw std::invalid_argument("external_sorting needs memory=");
+        }
+        if (suite.cases.empty()) {
+            suite.cases.push_back(TestCaseType::RANDOM);
+        }
+        if (!suite.algorithms.empty()) {
+            if (Benchmark::engine_capabilities(suite.type) == 0) {
+                throw std::invalid_argument("only sorting and selection take algorithms=");
+            }
+            // Throws for unknown ids before anything runs
+            AlgorithmRegistry::select(Benchmark::engine_capabilities(suite.type), suite.algorithms);
+        }
+        if (!suite.placements.empty() && Benchmark::engine_capabilities(suite.type) == 0) {
+            throw std::invalid_argument("only sorting and selection take placements=");
+        }
+        if (suite.type == AlgorithmType::RECORD_SORTING && suite.payloads.empty()) {
+            suite.payloads.assign(std::begin(Benchmark::RECORD_PAYLOAD_SIZES), std::end(Benchmark::RECORD_PAYLOAD_SIZES));
+        }
+        for (size_t payload : suite.payloads) {
+            if (std::find(std::begin(Benchmark::RECORD_PAYLOAD_SIZES), std::end(Benchmark::RECORD_PAYLOAD_SIZES), payload) ==
+                std::end(Benchmark::RECORD_PAYLOAD_SIZES)) {
+                throw std::invalid_argument("unsupported payload size " + std::to_string(payload));
+            }
+        }
+        for (size_t size : suite.sizes) {
+            for (TestCaseType test_case : suite.cases) {
+                plan.configs.push_back({suite.type, size, test_case, testName(suite.type, size, test_case),
+                                        suite.threads, suite.ranks, suite.memory_budget, suite.fan_in});
+                plan.configs.back().algorithms = suite.algorithms;
+                plan.configs.back().payload_sizes = suite.payloads;
+                plan.configs.back().placements = suite.placements;
+            }
+        }
+    }
+
+    // Configurations grouped by output file, in the order they were given
+    static std::vector<Job> makeJobs(const Plan& plan) {
+        std::vector<Job> jobs;
+        std::map<std::string, size_t> job_by_file;
+        for (const BenchmarkConfig& config : plan.configs) {
+            std::string filename = Benchmark::generate_filename(config);
+            auto it = job_by_file.find(filename);
+            if (it == job_by_file.end()) {
+                it = job_by_file.emplace(filename, jobs.size()).first;
+                jobs.emplace_back();
+            }
+            Job& job = jobs[it->second];
+            job.configs.push_back(config);
+            job.configs.back().seed = configSeed(plan.settings.seed, config);
+            job.cost += estimatedCost(config);
+            job.exclusive = job.exclusive || !config.thread_counts.empty() ||
+                            config.algorithm_type == AlgorithmType::EXTERNAL_SORTING ||
+                            config.algorithm_type == AlgorithmType::LARGE_SCALE ||
+                            config.algorithm_type == AlgorithmType::STREAMING_SELECTION;
+        }
+        return jobs;
+    }
+
+    // Relative work of one iteration: n log n times how many engine runs it makes,
+    // selection engines counting a fifth of a sort
+    static double estimatedCost(const BenchmarkConfig& config) {
+        double n = static_cast<double>(config.vector_size);
+        double n_log_n = n * std::log2(std::max(2.0, n));
+        if (config.algorithm_type == AlgorithmType::EXTERNAL_SORTING) {
+            return n_log_n * 20.0;
+        }
+        if (config.algorithm_type == AlgorithmType::LARGE_SCALE) {
+            // Four 64-bit sorts, a selection and the O(n) checks
+            return n_log_n * 5.0;
+        }
+        if (config.algorithm_type == AlgorithmType::STREAMING_SELECTION) {
+            // Two streaming passes and their checks, each O(n) but bound by the disk
+            return n * 8.0;
+        }
+        if (config.algorithm_type == AlgorithmType::RECORD_SORTING) {
+            // Four record sorts per payload size plus the two argsorts, slower than int sorts
+            return n_log_n * 2.0 * (2.0 + 4.0 * config.payload_sizes.size());
+        }
+        double runs = 0.0;
+        for (const AlgorithmEntry* entry :
+             AlgorithmRegistry::select(Benchmark::engine_capabilities(config.algorithm_type), config.algorithms)) {
+            runs += entry->has(PARALLEL) ? config.thread_counts.size()
+                  : entry->has(SELECTS_MANY) ? config.rank_counts.size() : 1.0;
+        }
+        runs *= std::max<size_t>(1, config.placements.size());
+        return n_log_n * (config.algorithm_type == AlgorithmType::SELECTION ? runs / 5.0 : runs);
+    }
+
+    // FNV-1a of the case name and size, mixed with the base seed
+    static uint64_t configSeed(uint64_t base_seed, const BenchmarkConfig& config) {
+        if (base_seed == 0) return 0;
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : Benchmark::get_test_case_name(config.test_case) + "_" + std::to_string(config.vector_size)) {
+            hash = (hash ^ c) * 1099511628211ULL;
+        }
+        uint64_t z = SplitMix64(base_seed + hash).next();
+        return z != 0 ? z : 1;
+    }
+
+    static std::string testName(AlgorithmType type, size_t size, TestCaseType test_case) {
+        std::string name = type == AlgorithmType::SORTING ? "SORTING"
+                         : type == AlgorithmType::SELECTION ? "SELECTION"
+                         : type == AlgorithmType::EXTERNAL_SORTING ? "EXTERNAL SORTING"
+                         : type == AlgorithmType::RECORD_SORTING ? "RECORD SORTING"
+                         : type == AlgorithmType::LARGE_SCALE ? "LARGE SCALE" : "STREAMING SELECTION";
+        std::string size_label = size % 1000000 == 0 ? std::to_string(size / 1000000) + "M"
+                               : size % 1000 == 0 ? std::to_string(size / 1000) + "K" : std::to_string(size);
+        std::string case_label = Benchmark::get_test_case_name(test_case);
+        std::transform(case_label.begin(), case_label.end(), case_label.begin(), ::toupper);
+        return name + " " + size_label + " " + case_label;
+    }
+
+    static TestCaseType parseTestCase(const std::string& name) {
+        for (TestCaseType test_case : {TestCaseType::RANDOM, TestCaseType::NEARLY_SORTED, TestCaseType::REVERSE_SORTED,
+                                       TestCaseType::FEW_UNIQUE, TestCaseType::ZIPF, TestCaseType::ORGAN_PIPE,
+                                       TestCaseType::SAWTOOTH, TestCaseType::SORTED_RUNS, TestCaseType::ALL_EQUAL}) {
+            if (Benchmark::get_test_case_name(test_case) == name) return test_case;
+        }
+        throw std::invalid_argument("unknown case '" + name + "'");
+    }
+
+    static std::vector<std::string> split(const std::string& list) {
+        std::vector<std::string> items;
+        std::istringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    // Unsigned integer with an optional K, M, G (powers of 1000) or Ki, Mi, Gi (powers of 1024) suffix
+    static size_t parseSize(const std::string& text) {
+        size_t end = 0;
+        unsigned long long value = 0;
+        try {
+            value = std::stoull(text, &end);
+        } catch (const std::exception&) {
+            throw std::invalid_argument("expected a number, got '" + text + "'");
+        }
+        std::string suffix = text.substr(end);
+        if (suffix == "k" || suffix == "K") return value * 1000;
+        if (suffix == "m" || suffix == "M") return value * 1000000;
+        if (suffix == "g" || suffix == "G") return value * 1000000000;
+        if (suffix == "Ki") return value << 10;
+        if (suffix == "Mi") return value << 20;
+        if (suffix == "Gi") return value << 30;
+        if (!suffix.empty()) throw std::invalid_argument("bad number suffix in '" + text + "'");
+        return value;
+    }
+
+    static std::vector<size_t> parseSizes(const std::string& list) {
+        std::vector<size_t> values;
+        for (const std::string& item : split(list)) values.push_back(parseSize(item));
+        return values;
+    }
+
+    static double parseDouble(const std::string& text) {
+        try {
+            return std::stod(text);
+        } catch (const std::exception&) {
+            throw std::invalid_argument("expected a number, got '" + text + "'");
+        }
+    }
+};
+
+#endif // BENCHMARK_RUNNER_H
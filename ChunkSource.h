@@ -0,0 +1,100 @@
+#ifndef CHUNK_SOURCE_H
+#define CHUNK_SOURCE_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdio>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include "Span.h"
+
+/**
+ * @class ChunkSource
+ * @brief Sequential source of ints consumed in fixed-size chunks.
+ *
+ * Streaming algorithms only ever see one chunk at a time, so the input can be
+ * far larger than the available memory.
+ */
+class ChunkSource {
+public:
+    virtual ~ChunkSource() = default;
+
+    /**
+     * Copies up to max_count values into out.
+     * @return The number of values written, 0 once the stream is exhausted
+     */
+    virtual size_t read(int* out, size_t max_count) = 0;
+};
+
+/**
+ * @class FileChunkSource
+ * @brief Reads native-endian 32-bit ints from a binary file.
+ */
+class FileChunkSource : public ChunkSource {
+private:
+    std::FILE* file;
+
+public:
+    explicit FileChunkSource(const std::string& path) : file(std::fopen(path.c_str(), "rb")) {
+        if (file == nullptr) {
+            throw std::runtime_error("Cannot open input file: " + path);
+        }
+    }
+
+    ~FileChunkSource() override {
+        std::fclose(file);
+    }
+
+    FileChunkSource(const FileChunkSource&) = delete;
+    FileChunkSource& operator=(const FileChunkSource&) = delete;
+
+    size_t read(int* out, size_t max_count) override {
+        return std::fread(out, sizeof(int), max_count, file);
+    }
+};
+
+/**
+ * @class GeneratorChunkSource
+ * @brief Produces count values by calling a generator function.
+ */
+class GeneratorChunkSource : public ChunkSource {
+private:
+    std::function<int()> generator;
+    size_t remaining;
+
+public:
+    GeneratorChunkSource(std::function<int()> generator, size_t count) : generator(std::move(generator)), remaining(count) {}
+
+    size_t read(int* out, size_t max_count) override {
+        size_t count = std::min(max_count, remaining);
+        for (size_t i = 0; i < count; i++) {
+            out[i] = generator();
+        }
+        remaining -= count;
+        return count;
+    }
+};
+
+/**
+ * @class VectorChunkSource
+ * @brief Streams an in-memory range, so streaming engines can run on benchmark inputs.
+ */
+class VectorChunkSource : public ChunkSource {
+private:
+    Span<const int> data;
+    size_t position;
+
+public:
+    explicit VectorChunkSource(Span<const int> data) : data(data), position(0) {}
+
+    size_t read(int* out, size_t max_count) override {
+        size_t count = std::min(max_count, data.size() - position);
+        std::copy(data.begin() + position, data.begin() + position + count, out);
+        position += count;
+        return count;
+    }
+};
+
+#endif // CHUNK_SOURCE_H
@@ -0,0 +1,114 @@
+#ifndef CPU_AFFINITY_H
+#define CPU_AFFINITY_H
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @class CpuAffinity
+ * @brief Pins benchmark threads to a single core.
+ *
+ * The affinity mask the process started with is remembered on first use, so
+ * code that creates worker threads from a pinned thread (the parallel sorters'
+ * pools) can hand them the full set of cores again with an Unpinned scope.
+ * Everything is a no-op outside Linux.
+ */
+class CpuAffinity {
+private:
+#ifdef __linux__
+    static const cpu_set_t& initialMask() {
+        static const cpu_set_t mask = [] {
+            cpu_set_t initial;
+            CPU_ZERO(&initial);
+            if (sched_getaffinity(0, sizeof(initial), &initial) != 0) {
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &initial);
+            }
+            return initial;
+        }();
+        return mask;
+    }
+#endif
+
+public:
+    /**
+     * @brief Restricts the calling thread to one core.
+     *
+     * @param cpu Index into the cores the process was allowed to run on at start
+     * @return false when the core does not exist or pinning is not supported
+     */
+    static bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+        const cpu_set_t& initial = initialMask();
+        int seen = 0;
+        for (int core = 0; core < CPU_SETSIZE; core++) {
+            if (!CPU_ISSET(core, &initial)) continue;
+            if (seen++ == cpu) {
+                cpu_set_t pinned;
+                CPU_ZERO(&pinned);
+                CPU_SET(core, &pinned);
+                return sched_setaffinity(0, sizeof(pinned), &pinned) == 0;
+            }
+        }
+#endif
+        (void)cpu;
+        return false;
+    }
+
+    // Number of cores the process was allowed to run on at start
+    static int availableCores() {
+#ifdef __linux__
+        return CPU_COUNT(&initialMask());
+#else
+        return 1;
+#endif
+    }
+
+    // Number of cores the calling thread may run on now, 1 when pinned
+    static int currentCores() {
+#ifdef __linux__
+        cpu_set_t current;
+        CPU_ZERO(&current);
+        if (sched_getaffinity(0, sizeof(current), &current) == 0) {
+            return CPU_COUNT(&current);
+        }
+        return availableCores();
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     * @brief Gives the calling thread the process's initial affinity for the lifetime
+     * of the scope, then restores its previous mask. Threads started inside the
+     * scope inherit the initial mask.
+     */
+    class Unpinned {
+    private:
+#ifdef __linux__
+        cpu_set_t previous;
+        bool restore = false;
+#endif
+
+    public:
+        Unpinned() {
+#ifdef __linux__
+            CPU_ZERO(&previous);
+            const cpu_set_t& initial = initialMask();
+            restore = sched_getaffinity(0, sizeof(previous), &previous) == 0 &&
+                      sched_setaffinity(0, sizeof(initial), &initial) == 0;
+#endif
+        }
+
+        ~Unpinned() {
+#ifdef __linux__
+            if (restore) sched_setaffinity(0, sizeof(previous), &previous);
+#endif
+        }
+
+        Unpinned(const Unpinned&) = delete;
+        Unpinned& operator=(const Unpinned&) = delete;
+    };
+};
+
+#endif // CPU_AFFINITY_H
@@ -0,0 +1,47 @@
+#ifndef INPUT_ARENA_H
+#define INPUT_ARENA_H
+
+#include <cstring>
+#include <vector>
+#include "Span.h"
+#include "PageAllocator.h"
+
+/**
+ * @class InputArena
+ * @brief Reusable working buffer the in-place algorithms run on.
+ *
+ * Before every algorithm call the benchmark restores the pristine input into the
+ * arena with a single memcpy and hands the algorithm a Span over it. The buffer
+ * only grows, so after the first call per size there are no allocations, and the
+ * copy happens before the algorithm's timer and the measured scope start.
+ *
+ * The buffer is allocated with the thread's current placement (see PageAllocator);
+ * when a later call runs under a different placement the buffer is released and
+ * allocated again with it.
+ */
+class InputArena {
+private:
+    PlacedVector<int> buffer;
+
+public:
+    // Grows the buffer to hold size elements, touching every page up front
+    void reserve(size_t size) {
+        if (buffer.get_allocator().placement() != PageAllocator::current()) {
+            buffer = PlacedVector<int>();
+        }
+        if (buffer.size() < size) {
+            buffer.resize(size);
+        }
+    }
+
+    // Copies input into the buffer and returns a view of the copy
+    Span<int> restore(const std::vector<int>& input) {
+        reserve(input.size());
+        if (!input.empty()) {
+            std::memcpy(buffer.data(), input.data(), input.size() * sizeof(int));
+        }
+        return Span<int>(buffer.data(), input.size());
+    }
+};
+
+#endif // INPUT_ARENA_H
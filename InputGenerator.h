@@ -0,0 +1,242 @@
+#ifndef INPUT_GENERATOR_H
+#define INPUT_GENERATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "CpuAffinity.h"
+
+/**
+ * SplitMix64: a tiny generator used to expand one 64-bit seed into the state of
+ * the other generators and into independent per-block seeds.
+ */
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * xoshiro256++ (Blackman and Vigna): fast, 256 bits of state, passes BigCrush.
+ * Satisfies UniformRandomBitGenerator, so it also works with <random> distributions.
+ */
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed) {
+        SplitMix64 seeder(seed);
+        for (uint64_t& word : s) word = seeder.next();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, range) by Lemire's multiply-shift; the bias is below 2^-32 for range < 2^32
+    uint64_t below(uint64_t range) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>((*this)()) * range) >> 64);
+    }
+
+    // Uniform in [0, 1)
+    double unit() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+};
+
+/**
+ * Zipf distribution over 1..n with P(k) proportional to 1 / k^exponent, sampled in
+ * O(1) without a table by rejection-inversion (Hormann and Derflinger, 1996).
+ */
+class ZipfSampler {
+private:
+    double n;
+    double exponent;
+    double h_integral_x1;
+    double h_integral_n;
+    double s;
+
+    static double helper1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    static double helper2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+
+    double h(double x) const {
+        return std::exp(-exponent * std::log(x));
+    }
+
+    double hIntegral(double x) const {
+        double log_x = std::log(x);
+        return helper2((1.0 - exponent) * log_x) * log_x;
+    }
+
+    double hIntegralInverse(double x) const {
+        double t = std::max(-1.0, x * (1.0 - exponent));
+        return std::exp(helper1(t) * x);
+    }
+
+public:
+    ZipfSampler(uint64_t n, double exponent)
+        : n(static_cast<double>(std::max<uint64_t>(1, n))), exponent(exponent),
+          h_integral_x1(hIntegral(1.5) - 1.0),
+          h_integral_n(hIntegral(this->n + 0.5)),
+          s(2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0))) {}
+
+    uint64_t operator()(Xoshiro256& gen) const {
+        while (true) {
+            double u = h_integral_n + gen.unit() * (h_integral_x1 - h_integral_n);
+            double x = hIntegralInverse(u);
+            double k = std::min(n, std::max(1.0, std::floor(x + 0.5)));
+            if (k - x <= s || u >= hIntegral(k + 0.5) - h(k)) {
+                return static_cast<uint64_t>(k);
+            }
+        }
+    }
+};
+
+/**
+ * @class InputGenerator
+ * @brief Fills benchmark inputs in parallel, deterministically.
+ *
+ * The vector is cut into fixed-size blocks and every block gets its own Xoshiro256
+ * seeded from (seed, block index), so the output depends on the seed only, not on the
+ * number of threads. Generation threads inherit the caller's affinity: a benchmark
+ * pinned to one core generates on that core and leaves the others undisturbed.
+ */
+class InputGenerator {
+public:
+    static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+    // Turns seed 0 ("unseeded") into a fresh random seed
+    static uint64_t resolveSeed(uint64_t seed) {
+        if (seed != 0) return seed;
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+
+    /**
+     * @brief Calls fill(begin, end, gen) for every block of [0, size), spread over the
+     * cores the calling thread may run on.
+     */
+    template <typename Fill>
+    static void forEachBlock(size_t size, uint64_t seed, Fill fill) {
+        size_t blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        auto run_block = [&](size_t block) {
+            Xoshiro256 gen(SplitMix64(seed ^ (block * 0xD1B54A32D192ED03ULL)).next());
+            size_t begin = block * BLOCK_SIZE;
+            fill(begin, std::min(size, begin + BLOCK_SIZE), gen);
+        };
+
+        size_t thread_count = std::min<size_t>(blocks, static_cast<size_t>(CpuAffinity::currentCores()));
+        if (thread_count <= 1) {
+            for (size_t block = 0; block < blocks; block++) run_block(block);
+            return;
+        }
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; t++) {
+            threads.emplace_back([&, t] {
+                for (size_t block = t; block < blocks; block += thread_count) run_block(block);
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+    }
+};
+
+/**
+ * @class BasicInputCache
+ * @brief Generated inputs keyed by (distribution, size, seed), shared between all
+ * iterations and threads that ask for the same key.
+ *
+ * Entries are evicted oldest first once the cached inputs exceed the byte budget;
+ * the newest entry always stays, however large. Unseeded requests (seed 0) are
+ * never cached since they must differ every time.
+ *
+ * @tparam T Element type of the inputs
+ */
+template <typename T>
+class BasicInputCache {
+public:
+    using Key = std::tuple<int, size_t, uint64_t>;
+    using Input = std::shared_ptr<const std::vector<T>>;
+
+private:
+    std::mutex mutex;
+    std::map<Key, Input> entries;
+    std::list<Key> insertion_order;
+    size_t cached_bytes = 0;
+    size_t budget_bytes;
+
+public:
+    explicit BasicInputCache(size_t budget_bytes) : budget_bytes(budget_bytes) {}
+
+    template <typename Generate>
+    Input get(const Key& key, Generate generate) {
+        if (std::get<2>(key) == 0) {
+            return std::make_shared<const std::vector<T>>(generate());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) return it->second;
+        }
+
+        // Generate outside the lock; if two threads race on the same key both results are equal
+        Input input = std::make_shared<const std::vector<T>>(generate());
+        size_t bytes = input->size() * sizeof(T);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto inserted = entries.emplace(key, input);
+        if (!inserted.second) return inserted.first->second;
+        insertion_order.push_back(key);
+        cached_bytes += bytes;
+        while (cached_bytes > budget_bytes && insertion_order.size() > 1) {
+            auto oldest = entries.find(insertion_order.front());
+            cached_bytes -= oldest->second->size() * sizeof(T);
+            entries.erase(oldest);
+            insertion_order.pop_front();
+        }
+        return input;
+    }
+};
+
+using InputCache = BasicInputCache<int>;
+
+#endif // INPUT_GENERATOR_H
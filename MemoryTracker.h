@@ -0,0 +1,199 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <alloca.h>
+#include "AlgorithmResult.h"
+
+/**
+ * @class MemoryTracker
+ * @brief Measured memory use of one benchmark call: heap bytes and allocations seen
+ * by the global operator new/delete, peak resident set size and the stack high-water
+ * mark of the calling thread.
+ *
+ * The operator new/delete replacements are defined in the single translation unit
+ * that defines MEMORY_TRACKER_IMPLEMENTATION before including this header (main.cpp).
+ * They size blocks with malloc_usable_size, so they are only compiled on glibc; without
+ * them available() is false and the heap figures stay at zero.
+ *
+ * Heap accounting is per thread, so benchmarks running concurrently on different
+ * threads do not see each other's allocations. A block is charged to the thread that
+ * allocates it and credited to the thread that frees it; allocations pool workers make
+ * on behalf of a call (task closures, not the sorters' scratch buffers, which the
+ * calling thread allocates) are not attributed to it. The stack probe likewise only
+ * covers the calling thread. Peak RSS is inherently process wide and is not sampled
+ * while concurrent runs are enabled.
+ */
+class MemoryTracker {
+private:
+    static inline std::atomic<bool> hooks_active{false};
+    static inline std::atomic<bool> concurrent_runs{false};
+    // Signed, as a thread may free more than it allocated
+    static inline thread_local int64_t live_bytes = 0;
+    static inline thread_local int64_t peak_bytes = 0;
+    static inline thread_local uint64_t allocation_count = 0;
+
+    // Bytes of stack below the caller that are painted and scanned; deeper use saturates
+    static constexpr size_t STACK_PROBE_BYTES = 1 << 20;
+    static constexpr unsigned char STACK_PATTERN = 0xA5;
+
+public:
+    // Called by the operator new/delete replacements only
+    static void recordAllocation(size_t bytes) {
+        // Only written once, so the flag's cache line stays shared between threads
+        if (!hooks_active.load(std::memory_order_relaxed)) {
+            hooks_active.store(true, std::memory_order_relaxed);
+        }
+        allocation_count++;
+        live_bytes += static_cast<int64_t>(bytes);
+        if (live_bytes > peak_bytes) peak_bytes = live_bytes;
+    }
+
+    static void recordDeallocation(size_t bytes) {
+        live_bytes -= static_cast<int64_t>(bytes);
+    }
+
+    // True once the operator new hooks have seen an allocation
+    static bool available() {
+        return hooks_active.load(std::memory_order_relaxed);
+    }
+
+    // Set while several benchmarks run at once in this process; disables peak RSS sampling
+    static void setConcurrentRuns(bool concurrent) {
+        concurrent_runs.store(concurrent, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Heap counters of the calling thread relative to the moment the scope
+     * was opened.
+     *
+     * Opening a scope lowers the thread's peak to its current live size, so scopes
+     * on one thread must not overlap.
+     */
+    class Scope {
+    private:
+        int64_t start_live;
+        uint64_t start_allocations;
+
+    public:
+        Scope() : start_live(live_bytes), start_allocations(allocation_count) {
+            peak_bytes = start_live;
+        }
+
+        // Writes the heap figures accumulated so far into counters
+        void collect(MemoryCounters& counters) const {
+            counters.peak_heap_bytes = peak_bytes > start_live ? static_cast<size_t>(peak_bytes - start_live) : 0;
+            counters.retained_heap_bytes = live_bytes > start_live ? static_cast<size_t>(live_bytes - start_live) : 0;
+            counters.allocations = allocation_count - start_allocations;
+        }
+    };
+
+    /**
+     * Fills the stack area below the caller's frame with a known pattern. Must be
+     * called from the same frame that later calls stackHighWater().
+     */
+    __attribute__((noinline)) static void paintStack() {
+        unsigned char* region = static_cast<unsigned char*>(alloca(STACK_PROBE_BYTES));
+        std::memset(region, STACK_PATTERN, STACK_PROBE_BYTES);
+        asm volatile("" : : "r"(region) : "memory");
+    }
+
+    // Bytes of the painted area overwritten since paintStack(), i.e. the deepest stack use
+    __attribute__((noinline)) static size_t stackHighWater() {
+        volatile unsigned char* region = static_cast<unsigned char*>(alloca(STACK_PROBE_BYTES));
+        size_t untouched = 0;
+        while (untouched < STACK_PROBE_BYTES && region[untouched] == STACK_PATTERN) {
+            untouched++;
+        }
+        return STACK_PROBE_BYTES - untouched;
+    }
+
+    // Resets the kernel's peak RSS (VmHWM) to the current RSS; no-op where unsupported
+    static void resetPeakRss() {
+        if (concurrent_runs.load(std::memory_order_relaxed)) return;
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+    }
+
+    // Peak resident set size in bytes since the last reset, 0 when unknown or shared
+    static size_t peakRss() {
+        if (concurrent_runs.load(std::memory_order_relaxed)) return 0;
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) {
+                return std::stoull(line.substr(6)) * 1024;
+            }
+        }
+        return 0;
+    }
+};
+
+#if defined(MEMORY_TRACKER_IMPLEMENTATION) && defined(__GLIBC__)
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace memory_tracker_detail {
+    inline void* allocate(size_t size, size_t alignment) {
+        if (size == 0) size = 1;
+        void* ptr = nullptr;
+        if (alignment <= alignof(std::max_align_t)) {
+            ptr = std::malloc(size);
+        } else if (posix_memalign(&ptr, alignment, size) != 0) {
+            ptr = nullptr;
+        }
+        if (ptr) MemoryTracker::recordAllocation(malloc_usable_size(ptr));
+        return ptr;
+    }
+
+    inline void* allocate_or_throw(size_t size, size_t alignment) {
+        void* ptr = allocate(size, alignment);
+        if (!ptr) throw std::bad_alloc();
+        return ptr;
+    }
+
+    inline void deallocate(void* ptr) {
+        if (!ptr) return;
+        MemoryTracker::recordDeallocation(malloc_usable_size(ptr));
+        std::free(ptr);
+    }
+}
+
+void* operator new(size_t size) { return memory_tracker_detail::allocate_or_throw(size, 0); }
+void* operator new[](size_t size) { return memory_tracker_detail::allocate_or_throw(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return memory_tracker_detail::allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return memory_tracker_detail::allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return memory_tracker_detail::allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return memory_tracker_detail::allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return memory_tracker_detail::allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return memory_tracker_detail::allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { memory_tracker_detail::deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { memory_tracker_detail::deallocate(ptr); }
+#endif
+
+#endif // MEMORY_TRACKER_H
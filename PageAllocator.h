@@ -0,0 +1,257 @@
+#ifndef PAGE_ALLOCATOR_H
+#define PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MemoryTracker.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Where the pages of a large buffer come from:
+ *   - DEFAULT:    operator new, as any std::vector (the kernel's default policy and page size)
+ *   - THP:        anonymous mapping aligned to 2 MiB and madvise(MADV_HUGEPAGE)
+ *   - HUGETLB:    explicit huge pages (MAP_HUGETLB) from the reserved pool, THP when none are reserved
+ *   - LOCAL:      anonymous mapping bound to the node of the thread that first touches each page
+ *   - INTERLEAVE: anonymous mapping with its pages spread round-robin over every online node
+ */
+enum class MemoryPlacement {
+    DEFAULT,
+    THP,
+    HUGETLB,
+    LOCAL,
+    INTERLEAVE
+};
+
+/**
+ * @class PageAllocator
+ * @brief Allocates the benchmark's large buffers with a given page size and NUMA placement.
+ *
+ * Each thread has a current placement, set for a region of code with a Scope. A
+ * PlacedAllocator captures the placement current when it is constructed, so a
+ * PlacedVector created inside a scope keeps its placement for its whole life,
+ * including later growth. Blocks smaller than a huge page always come from
+ * operator new: neither huge pages nor node placement matter for them.
+ *
+ * Mapped blocks are reported to MemoryTracker like heap blocks, so the heap
+ * figures stay comparable between placements. Outside Linux every placement is
+ * served by operator new.
+ */
+class PageAllocator {
+private:
+    static inline thread_local MemoryPlacement current_placement = MemoryPlacement::DEFAULT;
+
+#ifdef __linux__
+    // Memory policy modes of mbind(2); libnuma's numaif.h is not required
+    static constexpr int MPOL_INTERLEAVE_MODE = 3;
+    static constexpr int MPOL_LOCAL_MODE = 4;
+    static constexpr size_t MAX_NODES = 1024;
+    static constexpr size_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+
+    // Mask of the online NUMA nodes, parsed once from sysfs ("0-1,4"); node 0 when unavailable
+    static const std::vector<unsigned long>& onlineNodes() {
+        static const std::vector<unsigned long> mask = [] {
+            std::vector<unsigned long> nodes(MAX_NODES / BITS_PER_WORD, 0);
+            std::ifstream online("/sys/devices/system/node/online");
+            std::string ranges;
+            if (!(online >> ranges)) ranges = "0";
+            std::stringstream list(ranges);
+            std::string range;
+            while (std::getline(list, range, ',')) {
+                size_t dash = range.find('-');
+                size_t first = std::stoul(range.substr(0, dash));
+                size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+                for (size_t node = first; node <= last && node < MAX_NODES; node++) {
+                    nodes[node / BITS_PER_WORD] |= 1UL << (node % BITS_PER_WORD);
+                }
+            }
+            return nodes;
+        }();
+        return mask;
+    }
+
+    // Reserves length bytes aligned to a huge page, explicit huge pages when asked and available
+    static void* map(size_t length, bool explicit_huge_pages) {
+        if (explicit_huge_pages) {
+            void* huge = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (huge != MAP_FAILED) return huge;
+        }
+        // Over-map by one huge page and trim both ends to the alignment
+        size_t padded = length + HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(uintptr_t(HUGE_PAGE_SIZE) - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        if (aligned + length < start + padded) munmap(reinterpret_cast<void*>(aligned + length), start + padded - aligned - length);
+        return reinterpret_cast<void*>(aligned);
+    }
+#endif
+
+public:
+    // Size of a transparent or explicit huge page on x86-64 and most arm64 kernels
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    static MemoryPlacement current() {
+        return current_placement;
+    }
+
+    /**
+     * @brief Makes placement the calling thread's current placement for the lifetime
+     * of the scope, then restores the previous one.
+     */
+    class Scope {
+    private:
+        MemoryPlacement previous;
+
+    public:
+        explicit Scope(MemoryPlacement placement) : previous(current_placement) {
+            current_placement = placement;
+        }
+
+        ~Scope() {
+            current_placement = previous;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Whether a block of bytes is mapped rather than taken from operator new
+    static bool mapped(size_t bytes, MemoryPlacement placement) {
+#ifdef __linux__
+        return placement != MemoryPlacement::DEFAULT && bytes >= HUGE_PAGE_SIZE;
+#else
+        (void)bytes;
+        (void)placement;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Allocates bytes with the given placement. Policies are applied before any
+     * page is touched; a policy the kernel rejects (no NUMA support) is ignored.
+     * @throws std::bad_alloc when the memory cannot be reserved
+     */
+    static void* allocate(size_t bytes, MemoryPlacement placement) {
+        if (!mapped(bytes, placement)) {
+            return ::operator new(bytes);
+        }
+#ifdef __linux__
+        size_t length = mappedLength(bytes);
+        void* block = map(length, placement == MemoryPlacement::HUGETLB);
+        if (placement == MemoryPlacement::THP || placement == MemoryPlacement::HUGETLB) {
+            // Also covers the HUGETLB fallback; a no-op on explicit huge pages
+            madvise(block, length, MADV_HUGEPAGE);
+        } else if (placement == MemoryPlacement::LOCAL) {
+            syscall(SYS_mbind, block, length, MPOL_LOCAL_MODE, nullptr, 0, 0);
+        } else if (placement == MemoryPlacement::INTERLEAVE) {
+            const std::vector<unsigned long>& nodes = onlineNodes();
+            syscall(SYS_mbind, block, length, MPOL_INTERLEAVE_MODE, nodes.data(), MAX_NODES + 1, 0);
+        }
+        if (MemoryTracker::available()) MemoryTracker::recordAllocation(bytes);
+        return block;
+#else
+        return nullptr;
+#endif
+    }
+
+    // Frees a block from allocate(bytes, placement), with the same arguments
+    static void deallocate(void* block, size_t bytes, MemoryPlacement placement) {
+        if (!mapped(bytes, placement)) {
+            ::operator delete(block);
+            return;
+        }
+#ifdef __linux__
+        munmap(block, mappedLength(bytes));
+        if (MemoryTracker::available()) MemoryTracker::recordDeallocation(bytes);
+#endif
+    }
+
+    // Mapped blocks are rounded up to whole huge pages, which explicit huge pages require
+    static size_t mappedLength(size_t bytes) {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+    static std::string name(MemoryPlacement placement) {
+        switch (placement) {
+            case MemoryPlacement::DEFAULT: return "default";
+            case MemoryPlacement::THP: return "thp";
+            case MemoryPlacement::HUGETLB: return "hugetlb";
+            case MemoryPlacement::LOCAL: return "local";
+            case MemoryPlacement::INTERLEAVE: return "interleave";
+        }
+        return "unknown";
+    }
+
+    // @throws std::invalid_argument for an unknown name
+    static MemoryPlacement parse(const std::string& text) {
+        for (MemoryPlacement placement : {MemoryPlacement::DEFAULT, MemoryPlacement::THP, MemoryPlacement::HUGETLB,
+                                          MemoryPlacement::LOCAL, MemoryPlacement::INTERLEAVE}) {
+            if (name(placement) == text) return placement;
+        }
+        throw std::invalid_argument("unknown placement '" + text + "'");
+    }
+};
+
+/**
+ * Standard allocator drawing from PageAllocator with the placement that was current
+ * on the thread that constructed it. Copies keep the placement.
+ */
+template <typename T>
+class PlacedAllocator {
+private:
+    MemoryPlacement memory_placement;
+
+    template <typename U>
+    friend class PlacedAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PlacedAllocator() : memory_placement(PageAllocator::current()) {}
+
+    template <typename U>
+    PlacedAllocator(const PlacedAllocator<U>& other) : memory_placement(other.memory_placement) {}
+
+    MemoryPlacement placement() const {
+        return memory_placement;
+    }
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(PageAllocator::allocate(count * sizeof(T), memory_placement));
+    }
+
+    void deallocate(T* block, size_t count) {
+        PageAllocator::deallocate(block, count * sizeof(T), memory_placement);
+    }
+
+    template <typename U>
+    bool operator==(const PlacedAllocator<U>& other) const {
+        return memory_placement == other.memory_placement;
+    }
+
+    template <typename U>
+    bool operator!=(const PlacedAllocator<U>& other) const {
+        return !(*this == other);
+    }
+};
+
+// Vector whose storage follows the placement current at its construction
+template <typename T>
+using PlacedVector = std::vector<T, PlacedAllocator<T>>;
+
+#endif // PAGE_ALLOCATOR_H
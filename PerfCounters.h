@@ -0,0 +1,126 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "AlgorithmResult.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class PerfCounters
+ * @brief Hardware counters (cycles, instructions, cache misses, branch mispredictions)
+ * read through Linux perf_event_open around one benchmark call.
+ *
+ * The events are opened once as a single group, so they are scheduled on the PMU
+ * together and describe the same interval. Events the kernel refuses (no PMU in a
+ * VM, perf_event_paranoid too strict, not Linux) are left out and reported as -1;
+ * when none can be opened, measure() simply runs the call. Only user-space events
+ * of the calling thread and of threads it spawns during the call are counted:
+ * threads that already exist, such as the workers of a ThreadPool, are not, so
+ * the benchmark leaves the counts of parallel engines empty.
+ */
+class PerfCounters {
+private:
+    static constexpr size_t EVENT_COUNT = 4;
+
+    // Descriptor per event, -1 when the event is not available
+    std::array<int, EVENT_COUNT> fds;
+    int leader_fd = -1;
+
+#ifdef __linux__
+    static constexpr std::array<uint64_t, EVENT_COUNT> EVENT_CONFIGS = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    static int open_event(uint64_t config, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group_fd == -1 ? 1 : 0;  // the leader starts and stops the whole group
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    // Counter value scaled up for the time the event was multiplexed out, -1 on failure
+    static int64_t read_event(int fd) {
+        uint64_t values[3] = {0, 0, 0};  // value, time enabled, time running
+        if (fd < 0 || read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+            return -1;
+        }
+        double scale = static_cast<double>(values[1]) / static_cast<double>(values[2]);
+        return static_cast<int64_t>(static_cast<double>(values[0]) * scale);
+    }
+#endif
+
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef __linux__
+        for (size_t i = 0; i < EVENT_COUNT; i++) {
+            fds[i] = open_event(EVENT_CONFIGS[i], leader_fd);
+            if (fds[i] >= 0 && leader_fd < 0) {
+                leader_fd = fds[i];
+            }
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True when at least one hardware event could be opened
+    bool available() const {
+        return leader_fd >= 0;
+    }
+
+    /**
+     * @brief Runs the call with the counter group enabled and attaches the counts
+     * to the AlgorithmResult it returns.
+     *
+     * @param run Callable returning an AlgorithmResult
+     */
+    template <typename Run>
+    AlgorithmResult measure(Run&& run) {
+#ifdef __linux__
+        if (available()) {
+            ioctl(leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            AlgorithmResult result = std::forward<Run>(run)();
+            ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            result.hardware.cycles = read_event(fds[0]);
+            result.hardware.instructions = read_event(fds[1]);
+            result.hardware.cache_misses = read_event(fds[2]);
+            result.hardware.branch_misses = read_event(fds[3]);
+            return result;
+        }
+#endif
+        return std::forward<Run>(run)();
+    }
+};
+
+#endif // PERF_COUNTERS_H
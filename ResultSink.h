@@ -0,0 +1,267 @@
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ResultSink
+ * @brief Collects benchmark rows in preallocated column buffers and writes them out
+ * in one go, as CSV and/or a compact binary columnar file.
+ *
+ * The first row defines the schema (column names and types). Later rows must add
+ * the same columns in the same order, which lets add() append by position with no
+ * lookups. Nothing touches the file system until flush(); with a background writer,
+ * flush() only hands the filled buffers to the writer thread and returns.
+ *
+ * Missing values are NULL_INT for integer columns and NaN for floating point
+ * columns, and are written as empty CSV fields.
+ *
+ * Columnar file layout (little endian), modelled on Parquet row groups:
+ *   header, written once:  "BCOL0001", uint32 column count,
+ *                          per column: uint8 type (0 int64, 1 float64, 2 string),
+ *                                      uint16 name length, name bytes
+ *   row group, per flush:  uint64 row count, then each column's values back to back
+ *                          (strings as uint32 length + bytes)
+ * output/columnar.py reads it back into a pandas DataFrame.
+ */
+class ResultSink {
+public:
+    static constexpr int64_t NULL_INT = std::numeric_limits<int64_t>::min();
+
+    enum class ColumnType : uint8_t { INT64 = 0, FLOAT64 = 1, STRING = 2 };
+
+private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        std::vector<int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<std::string> strings;
+    };
+
+    // Columns of one flush, written by the writer thread or inline
+    struct Batch {
+        std::vector<Column> columns;
+        size_t rows = 0;
+    };
+
+    std::string csv_path;
+    std::string columnar_path;
+    size_t expected_rows;
+
+    std::vector<Column> columns;
+    size_t rows = 0;
+    size_t cursor = 0;  // column the next add() fills
+    bool schema_complete = false;
+
+    bool background;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<Batch> pending;
+    bool stopping = false;
+
+    Column& next(const std::string& name, ColumnType type) {
+        if (!schema_complete) {
+            columns.push_back({name, type, {}, {}, {}});
+            Column& column = columns.back();
+            reserve(column);
+            cursor++;
+            return column;
+        }
+        if (cursor >= columns.size() || columns[cursor].type != type || columns[cursor].name != name) {
+            throw std::logic_error("ResultSink row does not match the schema at column " + name);
+        }
+        return columns[cursor++];
+    }
+
+    void reserve(Column& column) const {
+        switch (column.type) {
+            case ColumnType::INT64: column.ints.reserve(expected_rows); break;
+            case ColumnType::FLOAT64: column.doubles.reserve(expected_rows); break;
+            case ColumnType::STRING: column.strings.reserve(expected_rows); break;
+        }
+    }
+
+    static bool is_empty_file(std::ofstream& file) {
+        return file.tellp() == 0;
+    }
+
+    void write_csv(const Batch& batch) const {
+        std::ofstream outfile(csv_path, std::ios::app);
+        if (is_empty_file(outfile)) {
+            for (size_t c = 0; c < batch.columns.size(); c++) {
+                outfile << (c ? "," : "") << batch.columns[c].name;
+            }
+            outfile << "\n";
+        }
+        for (size_t row = 0; row < batch.rows; row++) {
+            for (size_t c = 0; c < batch.columns.size(); c++) {
+                const Column& column = batch.columns[c];
+                if (c) outfile << ",";
+                switch (column.type) {
+                    case ColumnType::INT64:
+                        if (column.ints[row] != NULL_INT) outfile << column.ints[row];
+                        break;
+                    case ColumnType::FLOAT64:
+                        if (!std::isnan(column.doubles[row])) outfile << column.doubles[row];
+                        break;
+                    case ColumnType::STRING:
+                        outfile << column.strings[row];
+                        break;
+                }
+            }
+            outfile << "\n";
+        }
+    }
+
+    template <typename T>
+    static void write_raw(std::ofstream& outfile, const T& value) {
+        outfile.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write_columnar(const Batch& batch) const {
+        std::ofstream outfile(columnar_path, std::ios::binary | std::ios::app);
+        if (is_empty_file(outfile)) {
+            outfile.write("BCOL0001", 8);
+            write_raw(outfile, static_cast<uint32_t>(batch.columns.size()));
+            for (const Column& column : batch.columns) {
+                write_raw(outfile, static_cast<uint8_t>(column.type));
+                write_raw(outfile, static_cast<uint16_t>(column.name.size()));
+                outfile.write(column.name.data(), column.name.size());
+            }
+        }
+        write_raw(outfile, static_cast<uint64_t>(batch.rows));
+        for (const Column& column : batch.columns) {
+            switch (column.type) {
+                case ColumnType::INT64:
+                    outfile.write(reinterpret_cast<const char*>(column.ints.data()), batch.rows * sizeof(int64_t));
+                    break;
+                case ColumnType::FLOAT64:
+                    outfile.write(reinterpret_cast<const char*>(column.doubles.data()), batch.rows * sizeof(double));
+                    break;
+                case ColumnType::STRING:
+                    for (const std::string& value : column.strings) {
+                        write_raw(outfile, static_cast<uint32_t>(value.size()));
+                        outfile.write(value.data(), value.size());
+                    }
+                    break;
+            }
+        }
+    }
+
+    void write(const Batch& batch) const {
+        if (batch.rows == 0) return;
+        if (!csv_path.empty()) write_csv(batch);
+        if (!columnar_path.empty()) write_columnar(batch);
+    }
+
+    void writer_loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ready.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return;
+            Batch batch = std::move(pending.front());
+            pending.pop_front();
+            lock.unlock();
+            write(batch);
+            lock.lock();
+        }
+    }
+
+public:
+    /**
+     * @param csv_path CSV file to append to, empty to skip CSV
+     * @param columnar_path Binary columnar file to append to, empty to skip it
+     * @param expected_rows Rows to preallocate per flush
+     * @param background Write from a background thread instead of inside flush()
+     */
+    ResultSink(std::string csv_path, std::string columnar_path, size_t expected_rows, bool background = false)
+        : csv_path(std::move(csv_path)), columnar_path(std::move(columnar_path)),
+          expected_rows(expected_rows), background(background) {
+        if (background) {
+            writer = std::thread(&ResultSink::writer_loop, this);
+        }
+    }
+
+    ~ResultSink() {
+        flush();
+        if (background) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            ready.notify_one();
+            writer.join();
+        }
+    }
+
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    void add(const std::string& name, int64_t value) {
+        next(name, ColumnType::INT64).ints.push_back(value);
+    }
+
+    void add(const std::string& name, double value) {
+        next(name, ColumnType::FLOAT64).doubles.push_back(value);
+    }
+
+    void add(const std::string& name, const std::string& value) {
+        next(name, ColumnType::STRING).strings.push_back(value);
+    }
+
+    void endRow() {
+        if (schema_complete && cursor != columns.size()) {
+            throw std::logic_error("ResultSink row has fewer columns than the schema");
+        }
+        schema_complete = true;
+        cursor = 0;
+        rows++;
+    }
+
+    size_t bufferedRows() const {
+        return rows;
+    }
+
+    // Writes the buffered rows (or queues them for the writer thread) and empties the buffers
+    void flush() {
+        if (rows == 0) return;
+        Batch batch;
+        batch.rows = rows;
+        batch.columns.reserve(columns.size());
+        for (Column& column : columns) {
+            batch.columns.push_back({column.name, column.type, std::move(column.ints),
+                                     std::move(column.doubles), std::move(column.strings)});
+            column.ints.clear();
+            column.doubles.clear();
+            column.strings.clear();
+            reserve(column);
+        }
+        rows = 0;
+
+        if (background) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.push_back(std::move(batch));
+            }
+            ready.notify_one();
+        } else {
+            write(batch);
+        }
+    }
+};
+
+#endif // RESULT_SINK_H
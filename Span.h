@@ -0,0 +1,48 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class Span
+ * @brief Non-owning view of a contiguous range, a minimal C++17 stand-in for std::span.
+ *
+ * The algorithms take their input as a Span<int> and work on it in place, so the
+ * caller decides where the data lives and when it is copied. Vectors convert
+ * implicitly, and a Span<T> converts to a Span<const T>.
+ */
+template <typename T>
+class Span {
+private:
+    T* pointer = nullptr;
+    size_t length = 0;
+
+public:
+    Span() = default;
+    Span(T* pointer, size_t length) : pointer(pointer), length(length) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    Span(std::vector<U>& vector) : pointer(vector.data()), length(vector.size()) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<const U*, T*>::value>>
+    Span(const std::vector<U>& vector) : pointer(vector.data()), length(vector.size()) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    Span(Span<U> other) : pointer(other.data()), length(other.size()) {}
+
+    T* data() const { return pointer; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    T& operator[](size_t index) const { return pointer[index]; }
+    T* begin() const { return pointer; }
+    T* end() const { return pointer + length; }
+
+    Span subspan(size_t offset, size_t count) const {
+        return Span(pointer + offset, count);
+    }
+};
+
+#endif // SPAN_H
@@ -0,0 +1,218 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+/**
+ * @class ThreadPool
+ * @brief Fork-join thread pool with one task deque per worker and work stealing.
+ *
+ * A pool of N threads owns N deques but only starts N - 1 worker threads: the
+ * thread that submits work and waits on a TaskGroup acts as the N-th worker,
+ * executing pending tasks while it waits. Workers pop from the back of their own
+ * deque (LIFO, cache friendly) and steal from the front of the others (FIFO,
+ * which tends to take the largest remaining subproblems).
+ */
+class ThreadPool {
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stopping;
+    std::atomic<size_t> pending_tasks;
+    std::mutex sleep_mutex;
+    std::condition_variable wake_up;
+
+    // Index of the queue owned by the current thread within the pool it belongs to
+    static inline thread_local const ThreadPool* current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    size_t ownQueueIndex() const {
+        // Threads outside the pool (the caller) use the last queue
+        return current_pool == this ? current_index : queues.size() - 1;
+    }
+
+    bool popLocal(size_t index, std::function<void()>& task) {
+        WorkQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, std::function<void()>& task) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            WorkQueue& queue = *queues[(thief + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t index) {
+        current_pool = this;
+        current_index = index;
+
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (!runPendingTask()) {
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wake_up.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                    return stopping.load(std::memory_order_acquire) || pending_tasks.load(std::memory_order_acquire) > 0;
+                });
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t thread_count) : stopping(false), pending_tasks(0) {
+        if (thread_count == 0) {
+            thread_count = 1;
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (size_t i = 0; i + 1 < thread_count; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ~ThreadPool() {
+        stopping.store(true, std::memory_order_release);
+        wake_up.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads taking part in the computation, including the caller
+    size_t size() const {
+        return queues.size();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            WorkQueue& queue = *queues[ownQueueIndex()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        pending_tasks.fetch_add(1, std::memory_order_release);
+        wake_up.notify_one();
+    }
+
+    /**
+     * Executes one pending task, preferring the current thread's own queue.
+     * @return true if a task was executed
+     */
+    bool runPendingTask() {
+        std::function<void()> task;
+        size_t index = ownQueueIndex();
+        if (!popLocal(index, task) && !steal(index, task)) {
+            return false;
+        }
+        pending_tasks.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+        return true;
+    }
+};
+
+/**
+ * @class TaskGroup
+ * @brief Tracks a set of tasks forked on a ThreadPool and joins them.
+ *
+ * wait() never blocks idly: the waiting thread keeps executing pending tasks,
+ * so nested fork-join recursion cannot deadlock the pool. A task that throws
+ * still counts as finished; the first exception of the group is kept and
+ * rethrown by wait() once every task is done.
+ */
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    std::atomic<size_t> outstanding;
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+
+    // Marks one task finished when it goes out of scope, however the task ended
+    struct Completion {
+        std::atomic<size_t>& outstanding;
+
+        ~Completion() {
+            outstanding.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    // Waits for every task without rethrowing its exception
+    void join() {
+        while (outstanding.load(std::memory_order_acquire) > 0) {
+            if (!pool.runPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool(pool), outstanding(0) {}
+
+    // Waits for the tasks still running; an exception no one waited for is dropped
+    ~TaskGroup() {
+        join();
+    }
+
+    void run(std::function<void()> task) {
+        outstanding.fetch_add(1, std::memory_order_relaxed);
+        try {
+            pool.submit([this, task = std::move(task)] {
+                Completion completion{outstanding};
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!first_error) first_error = std::current_exception();
+                }
+            });
+        } catch (...) {
+            // The task never reached the pool
+            outstanding.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Waits for every task of the group.
+     * @throws The first exception a task threw since the last wait()
+     */
+    void wait() {
+        join();
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            error = std::exchange(first_error, nullptr);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,84 @@
+#ifndef ARGSORT_H
+#define ARGSORT_H
+
+#include <vector>
+#include <chrono>
+#include <numeric>
+#include <functional>
+#include "../AlgorithmResult.h"
+#include "../Span.h"
+#include "MetricsPolicy.h"
+
+/**
+ * @class BasicArgsort
+ * @brief Indirect sort: computes the permutation that orders a key array without moving the keys.
+ *
+ * The index array is sorted by one of the generic sorters (BasicMergeSort, BasicQuickSort)
+ * with a comparator that looks both keys up, so every comparison reads the keys at
+ * two scattered positions while only 8-byte indices move. With a stable sorter
+ * (merge sort) equal keys keep their input order.
+ *
+ * @tparam Sorter Sorter template taking <Metrics, element type, comparator>
+ * @tparam Metrics Instrumentation policy (see MetricsPolicy.h)
+ * @tparam Key Key type
+ * @tparam KeyCompare Strict weak ordering of the keys
+ */
+template <template <typename, typename, typename> class Sorter, typename Metrics, typename Key = int, typename KeyCompare = std::less<Key>>
+class BasicArgsort {
+private:
+    // Orders indices by the keys of the current call
+    struct ByKey {
+        const BasicArgsort* owner;
+
+        bool operator()(size_t a, size_t b) const {
+            return owner->key_compare(owner->keys[a], owner->keys[b]);
+        }
+    };
+
+    // Keys of the call in progress
+    const Key* keys = nullptr;
+    KeyCompare key_compare;
+    Sorter<Metrics, size_t, ByKey> sorter;
+
+public:
+    /**
+     * @param strategy The sorter's mode (MergeSortMode or PartitionScheme)
+     * @param key_compare Key ordering
+     */
+    template <typename Strategy>
+    explicit BasicArgsort(Strategy strategy, KeyCompare key_compare = KeyCompare())
+        : key_compare(key_compare), sorter(strategy, false, ByKey{this}) {}
+
+    // The sorter's comparator points back at this object
+    BasicArgsort(const BasicArgsort&) = delete;
+    BasicArgsort& operator=(const BasicArgsort&) = delete;
+
+    /**
+     * @brief Fills permutation so that keys[permutation[0]], keys[permutation[1]], ... is sorted.
+     *
+     * @param keys The keys, left untouched
+     * @param[out] permutation Resized to keys.size(); its capacity is reused across calls
+     * @return AlgorithmResult with the sorter's comparisons; sorted stays empty
+     */
+    AlgorithmResult argsortWithMetrics(Span<const Key> keys, std::vector<size_t>& permutation) {
+        auto start_time = std::chrono::steady_clock::now();
+
+        this->keys = keys.data();
+        permutation.resize(keys.size());
+        std::iota(permutation.begin(), permutation.end(), size_t(0));
+        AlgorithmResult sort_result = sorter.sortWithMetrics(permutation);
+        this->keys = nullptr;
+
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // The index array on top of whatever the sorter needs for it
+        size_t memory_used = sizeof(size_t) * keys.size() + sort_result.memory_usage;
+
+        AlgorithmResult result = AlgorithmResult::forSorting("Argsort", {}, execution_time, sort_result.comparisons, memory_used);
+        result.swaps = sort_result.swaps;
+        return result;
+    }
+};
+
+#endif // ARGSORT_H
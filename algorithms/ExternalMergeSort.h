@@ -0,0 +1,441 @@
+#ifndef EXTERNAL_MERGESORT_H
+#define EXTERNAL_MERGESORT_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include "../AlgorithmResult.h"
+#include "MergeSort.h"
+
+/**
+ * @struct ExternalSortStats
+ * @brief I/O accounting of one external sort.
+ */
+struct ExternalSortStats {
+    uint64_t bytes_read = 0;
+    uint64_t bytes_written = 0;
+    size_t runs = 0;      // sorted runs produced by run formation
+    size_t passes = 0;    // passes over the data, run formation included
+};
+
+/**
+ * @class ExternalMergeSort
+ * @brief Out-of-core merge sort of binary files of native-endian 32-bit ints.
+ *
+ * Run formation reads memory-budget-sized runs with large sequential reads and
+ * sorts each one with the in-memory MergeSort (bottom-up with SIMD kernels).
+ * Runs are then merged fan_in at a time through a loser tree until one remains;
+ * the final pass writes the output file. Every input run and the output are
+ * double-buffered: the next block is read (or the previous one written) on a
+ * background thread while the current block is consumed (or filled).
+ *
+ * The memory budget covers either phase on its own: run formation holds one run
+ * and the sorter's scratch buffer, both released before merging starts, and a
+ * merge holds two blocks per input and two for the output.
+ */
+class ExternalMergeSort {
+private:
+    /**
+     * One I/O thread, kept for the life of a reader or writer, running one job at a
+     * time: submit() hands it a job, wait() blocks until it is done and returns its
+     * result, rethrowing what the job threw.
+     */
+    class IoThread {
+    private:
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::function<size_t()> job;
+        bool busy = false;
+        bool stopping = false;
+        size_t result = 0;
+        std::exception_ptr error;
+        std::thread thread;
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                changed.wait(lock, [this] { return stopping || job; });
+                if (!job) return;
+                std::function<size_t()> current = std::move(job);
+                job = nullptr;
+                lock.unlock();
+                size_t value = 0;
+                std::exception_ptr failure;
+                try {
+                    value = current();
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+                lock.lock();
+                result = value;
+                error = failure;
+                busy = false;
+                changed.notify_all();
+            }
+        }
+
+    public:
+        IoThread() : thread(&IoThread::loop, this) {}
+
+        ~IoThread() {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this] { return !busy; });
+                stopping = true;
+            }
+            changed.notify_all();
+            thread.join();
+        }
+
+        IoThread(const IoThread&) = delete;
+        IoThread& operator=(const IoThread&) = delete;
+
+        // Only call when no job is pending
+        void submit(std::function<size_t()> next_job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job = std::move(next_job);
+                busy = true;
+            }
+            changed.notify_all();
+        }
+
+        size_t wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return !busy; });
+            if (error) {
+                std::exception_ptr failure = error;
+                error = nullptr;
+                std::rethrow_exception(failure);
+            }
+            return result;
+        }
+    };
+
+    /**
+     * Reads a run file block by block, prefetching the next block asynchronously.
+     */
+    class RunReader {
+    private:
+        std::FILE* file;
+        std::vector<int> current;
+        std::vector<int> next;
+        size_t position;
+        size_t available;
+        uint64_t& bytes_read;
+        // Whether a read of the next block has been handed to the I/O thread
+        bool prefetching = false;
+        IoThread io;
+
+        void prefetch() {
+            io.submit([this] { return std::fread(next.data(), sizeof(int), next.size(), file); });
+            prefetching = true;
+        }
+
+    public:
+        RunReader(const std::string& path, size_t block_ints, uint64_t& bytes_read)
+            : file(std::fopen(path.c_str(), "rb")), current(block_ints), next(block_ints), position(0), available(0), bytes_read(bytes_read) {
+            if (file == nullptr) {
+                throw std::runtime_error("Cannot open run file: " + path);
+            }
+            prefetch();
+        }
+
+        ~RunReader() {
+            if (prefetching) {
+                io.wait();
+            }
+            std::fclose(file);
+        }
+
+        RunReader(const RunReader&) = delete;
+        RunReader& operator=(const RunReader&) = delete;
+
+        bool next_value(int& value) {
+            if (position == available) {
+                if (!prefetching) {
+                    return false;
+                }
+                prefetching = false;
+                available = io.wait();
+                bytes_read += available * sizeof(int);
+                position = 0;
+                if (available == 0) {
+                    return false;
+                }
+                current.swap(next);
+                if (available == current.size()) {
+                    prefetch();
+                }
+            }
+            value = current[position++];
+            return true;
+        }
+    };
+
+    /**
+     * Writes a run file block by block, flushing the previous block asynchronously.
+     */
+    class RunWriter {
+    private:
+        std::FILE* file;
+        std::vector<int> current;
+        std::vector<int> flushing;
+        size_t position;
+        uint64_t& bytes_written;
+        // Whether a write of the flushing block has been handed to the I/O thread
+        bool writing = false;
+        IoThread io;
+
+        void finishWrite() {
+            if (writing) {
+                writing = false;
+                io.wait();
+            }
+        }
+
+        void flush() {
+            finishWrite();
+            current.swap(flushing);
+            size_t count = position;
+            position = 0;
+            bytes_written += count * sizeof(int);
+            io.submit([this, count] {
+                if (std::fwrite(flushing.data(), sizeof(int), count, file) != count) {
+                    throw std::runtime_error("Short write to run file");
+                }
+                return count;
+            });
+            writing = true;
+        }
+
+    public:
+        RunWriter(const std::string& path, size_t block_ints, uint64_t& bytes_written)
+            : file(std::fopen(path.c_str(), "wb")), current(block_ints), flushing(block_ints), position(0), bytes_written(bytes_written) {
+            if (file == nullptr) {
+                throw std::runtime_error("Cannot create run file: " + path);
+            }
+        }
+
+        ~RunWriter() {
+            try {
+                finishWrite();
+            } catch (...) {
+                // Only reached while unwinding or without close(); close() reports write errors
+            }
+            std::fclose(file);
+        }
+
+        RunWriter(const RunWriter&) = delete;
+        RunWriter& operator=(const RunWriter&) = delete;
+
+        void push(int value) {
+            current[position++] = value;
+            if (position == current.size()) {
+                flush();
+            }
+        }
+
+        void close() {
+            if (position > 0) {
+                flush();
+            }
+            finishWrite();
+        }
+    };
+
+    size_t memory_budget;
+    size_t fan_in;
+    std::filesystem::path temp_directory;
+    uint64_t comparisons;
+    uint64_t vector_comparisons;
+    ExternalSortStats io_stats;
+
+    std::string runPath(size_t pass, size_t index) const {
+        return (temp_directory / ("run_" + std::to_string(pass) + "_" + std::to_string(index) + ".bin")).string();
+    }
+
+    std::vector<std::string> formRuns(const std::string& input_path);
+    void mergeRuns(const std::vector<std::string>& inputs, const std::string& output_path);
+
+public:
+    /**
+     * @param memory_budget Bytes of RAM the sort may use for runs and I/O buffers
+     * @param fan_in Number of runs merged together in one merge step
+     * @param temp_directory Directory for the intermediate run files
+     */
+    ExternalMergeSort(size_t memory_budget, size_t fan_in, std::filesystem::path temp_directory = std::filesystem::temp_directory_path())
+        : memory_budget(memory_budget), fan_in(fan_in), temp_directory(std::move(temp_directory)), comparisons(0), vector_comparisons(0) {
+        if (fan_in < 2) {
+            throw std::invalid_argument("fan_in must be at least 2");
+        }
+        if (memory_budget < 2 * (fan_in + 1) * 1024 * sizeof(int)) {
+            throw std::invalid_argument("memory budget too small for the requested fan_in");
+        }
+    }
+
+    /**
+     * @brief Sorts input_path into output_path with performance metrics.
+     * @return AlgorithmResult with an empty sorted view; see stats() for the I/O figures
+     */
+    AlgorithmResult sortFileWithMetrics(const std::string& input_path, const std::string& output_path);
+
+    const ExternalSortStats& stats() const {
+        return io_stats;
+    }
+};
+
+// Implementation of the methods
+inline std::vector<std::string> ExternalMergeSort::formRuns(const std::string& input_path) {
+    std::FILE* input = std::fopen(input_path.c_str(), "rb");
+    if (input == nullptr) {
+        throw std::runtime_error("Cannot open input file: " + input_path);
+    }
+
+    // Half of the budget holds the run, the other half is the sorter's scratch buffer;
+    // both are locals, so the merge phase gets the whole budget back
+    size_t run_ints = memory_budget / (2 * sizeof(int));
+    std::vector<std::string> runs;
+    std::vector<int> run(run_ints);
+    MergeSort run_sorter(MergeSortMode::BOTTOM_UP, true);
+
+    size_t read_count;
+    while ((read_count = std::fread(run.data(), sizeof(int), run_ints, input)) > 0) {
+        io_stats.bytes_read += read_count * sizeof(int);
+        run.resize(read_count);
+
+        AlgorithmResult sorted = run_sorter.sortWithMetrics(run);
+        comparisons += sorted.comparisons;
+        vector_comparisons += sorted.vector_comparisons;
+
+        std::string path = runPath(0, runs.size());
+        std::FILE* output = std::fopen(path.c_str(), "wb");
+        if (output == nullptr || std::fwrite(run.data(), sizeof(int), run.size(), output) != run.size()) {
+            if (output != nullptr) std::fclose(output);
+            std::fclose(input);
+            throw std::runtime_error("Cannot write run file: " + path);
+        }
+        std::fclose(output);
+        io_stats.bytes_written += run.size() * sizeof(int);
+        runs.push_back(path);
+
+        run.resize(run_ints);
+    }
+    std::fclose(input);
+    return runs;
+}
+
+inline void ExternalMergeSort::mergeRuns(const std::vector<std::string>& inputs, const std::string& output_path) {
+    int k = static_cast<int>(inputs.size());
+
+    // Two blocks per input plus two for the output share the budget
+    size_t block_ints = std::max<size_t>(1024, memory_budget / (2 * (inputs.size() + 1) * sizeof(int)));
+
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<int> keys(k);
+    std::vector<bool> active(k);
+    for (int i = 0; i < k; i++) {
+        readers.push_back(std::make_unique<RunReader>(inputs[i], block_ints, io_stats.bytes_read));
+        active[i] = readers[i]->next_value(keys[i]);
+    }
+    RunWriter writer(output_path, block_ints, io_stats.bytes_written);
+
+    // Exhausted inputs lose against everything; ties go to the lower index
+    auto beats = [&](int a, int b) {
+        if (!active[a]) return false;
+        if (!active[b]) return true;
+        comparisons++;
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    };
+
+    // Loser tree: tree[1..k-1] hold the loser of each match, tree[0] the overall winner
+    std::vector<int> tree(k, -1);
+    auto replay = [&](int s, bool building) {
+        for (int t = (s + k) / 2; t > 0; t /= 2) {
+            if (building && tree[t] == -1) {
+                tree[t] = s;
+                return;
+            }
+            if (beats(tree[t], s)) {
+                std::swap(s, tree[t]);
+            }
+        }
+        tree[0] = s;
+    };
+    for (int i = 0; i < k; i++) {
+        replay(i, true);
+    }
+
+    while (active[tree[0]]) {
+        int winner = tree[0];
+        writer.push(keys[winner]);
+        active[winner] = readers[winner]->next_value(keys[winner]);
+        replay(winner, false);
+    }
+    writer.close();
+}
+
+inline AlgorithmResult ExternalMergeSort::sortFileWithMetrics(const std::string& input_path, const std::string& output_path) {
+    auto start_time = std::chrono::steady_clock::now();
+    comparisons = 0;
+    vector_comparisons = 0;
+    io_stats = ExternalSortStats();
+
+    std::vector<std::string> runs = formRuns(input_path);
+    io_stats.runs = runs.size();
+    io_stats.passes = 1;
+
+    if (runs.empty()) {
+        // Empty input: produce an empty output file
+        std::FILE* output = std::fopen(output_path.c_str(), "wb");
+        if (output != nullptr) std::fclose(output);
+    } else if (runs.size() == 1) {
+        // The input fit in a single run, which already is the sorted output
+        std::filesystem::copy_file(runs[0], output_path, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::remove(runs[0]);
+        runs.clear();
+    }
+
+    size_t pass = 1;
+    while (!runs.empty()) {
+        bool last_pass = runs.size() <= fan_in;
+        std::vector<std::string> merged;
+
+        for (size_t first = 0; first < runs.size(); first += fan_in) {
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + fan_in));
+            std::string target = last_pass ? output_path : runPath(pass, merged.size());
+            mergeRuns(group, target);
+            for (const auto& path : group) {
+                std::filesystem::remove(path);
+            }
+            merged.push_back(target);
+        }
+
+        io_stats.passes++;
+        pass++;
+        if (last_pass) {
+            break;
+        }
+        runs = std::move(merged);
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+    AlgorithmResult result = AlgorithmResult::forSorting("ExternalMergeSort", {}, execution_time, comparisons, memory_budget);
+    result.vector_comparisons = vector_comparisons;
+    return result;
+}
+
+#endif // EXTERNAL_MERGESORT_H
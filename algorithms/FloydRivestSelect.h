@@ -0,0 +1,159 @@
+#ifndef FLOYD_RIVEST_SELECT_H
+#define FLOYD_RIVEST_SELECT_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "SelectLinearInPlace.h"
+
+/**
+ * @class FloydRivestSelect
+ * @brief Iterative Floyd-Rivest selection with a median-of-medians safety net.
+ *
+ * Each round draws a random sample of about n^(2/3) elements into the front of the
+ * active range, picks two sample order statistics that bracket rank k with high
+ * probability and partitions the range into < u, [u, v] and > v in one pass. The
+ * active range then narrows to the part holding k. Ranges of at most SAMPLE_THRESHOLD
+ * elements use a single random pivot instead. A round that keeps more than 3/4 of the
+ * range counts as a stall; after MAX_STALLS stalls the remaining range is handed to
+ * the in-place median-of-medians, which bounds the worst case at O(n).
+ *
+ * The random generator is per instance, so separate instances are thread-safe and
+ * pivots are free of modulo bias.
+ */
+class FloydRivestSelect {
+private:
+    static constexpr size_t SAMPLE_THRESHOLD = 600;
+    static constexpr int MAX_STALLS = 3;
+
+    std::mt19937_64 gen;
+    SelectLinearInPlace fallback;
+    uint64_t comparison_count;
+
+    size_t randomIndex(size_t left, size_t right) {
+        std::uniform_int_distribution<size_t> distrib(left, right);
+        return distrib(gen);
+    }
+
+    // Chooses the pivot pair [low_pivot, high_pivot] expected to bracket rank k
+    void choosePivots(int* data, size_t left, size_t right, size_t k, int& low_pivot, int& high_pivot) {
+        size_t size = right - left + 1;
+        if (size <= SAMPLE_THRESHOLD) {
+            low_pivot = high_pivot = data[randomIndex(left, right)];
+            return;
+        }
+
+        double n = static_cast<double>(size);
+        double z = std::log(n);
+        size_t sample_size = static_cast<size_t>(0.5 * std::exp(2.0 * z / 3.0));
+        double gap = 0.5 * std::sqrt(z * sample_size * (n - sample_size) / n);
+
+        // Move a uniform random sample to the front of the range (partial Fisher-Yates)
+        for (size_t i = 0; i < sample_size; i++) {
+            std::swap(data[left + i], data[randomIndex(left + i, right)]);
+        }
+
+        double rank = static_cast<double>(k - left) * sample_size / n;
+        size_t low_rank = static_cast<size_t>(std::max(0.0, rank - gap));
+        size_t high_rank = static_cast<size_t>(std::min(static_cast<double>(sample_size - 1), rank + gap));
+
+        size_t sample_end = left + sample_size - 1;
+        low_pivot = fallback.selectRange(data, left, sample_end, left + low_rank);
+        high_pivot = fallback.selectRange(data, left + low_rank, sample_end, left + high_rank);
+    }
+
+public:
+    explicit FloydRivestSelect(uint64_t seed = std::random_device{}()) : gen(seed), comparison_count(0) {}
+
+    /**
+     * @brief Finds the k-th smallest element with performance metrics.
+     *
+     * @param data The input array, reordered in place
+     * @param k The position of the element to find (0-based index)
+     * @return AlgorithmResult containing the result and performance metrics
+     */
+    AlgorithmResult selectWithMetrics(Span<int> data, size_t k) {
+        auto start_time = std::chrono::steady_clock::now();
+        comparison_count = 0;
+        fallback.resetMetrics();
+        
+        if (k >= data.size())
+            throw std::out_of_range("k is out of bounds");
+        
+        int* values = data.data();
+        size_t left = 0;
+        size_t right = data.size() - 1;
+        size_t target = k;
+        int stalls = 0;
+        int result = 0;
+        bool found = false;
+
+        while (!found) {
+            if (left == right) {
+                result = values[left];
+                break;
+            }
+            if (stalls >= MAX_STALLS) {
+                result = fallback.selectRange(values, left, right, target);
+                break;
+            }
+
+            int low_pivot, high_pivot;
+            choosePivots(values, left, right, target, low_pivot, high_pivot);
+
+            // [left, lt) < low_pivot, [lt, gt] within the pivots, (gt, right] > high_pivot
+            size_t lt = left, i = left, gt = right;
+            while (i <= gt) {
+                int value = values[i];
+                comparison_count++;
+                if (value < low_pivot) {
+                    std::swap(values[lt++], values[i++]);
+                } else {
+                    comparison_count++;
+                    if (value > high_pivot) {
+                        std::swap(values[i], values[gt]);
+                        gt--;
+                    } else {
+                        i++;
+                    }
+                }
+            }
+
+            size_t old_size = right - left + 1;
+            if (target < lt) {
+                right = lt - 1;
+            } else if (target > gt) {
+                left = gt + 1;
+            } else if (low_pivot == high_pivot) {
+                result = low_pivot;
+                found = true;
+            } else {
+                left = lt;
+                right = gt;
+            }
+
+            if (!found && 4 * (right - left + 1) > 3 * old_size) {
+                stalls++;
+            }
+        }
+        
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        
+        return AlgorithmResult::forSelection("FloydRivestSelect", result, execution_time,
+                                             comparison_count + fallback.comparisonCount(), fallback.peakMemory());
+    }
+};
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h)
+inline const bool floyd_rivest_registered = AlgorithmRegistry::add({"floyd_rivest", "Floyd-Rivest", SELECTS,
+    engineFactory<FloydRivestSelect>([](FloydRivestSelect& selector, const AlgorithmRequest& request) { return selector.selectWithMetrics(request.data, request.k); })});
+
+#endif // FLOYD_RIVEST_SELECT_H
@@ -0,0 +1,198 @@
+#ifndef INTROSORT_H
+#define INTROSORT_H
+
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <cstddef>
+#include <functional>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "MetricsPolicy.h"
+
+/**
+ * @class BasicIntroSort
+ * @brief Introsort-style QuickSort hardened against adversarial and duplicate-heavy inputs.
+ *
+ * - Median of three random samples as pivot, with a Dutch national flag (3-way) partition, so runs
+ *   of keys equal to the pivot are settled in a single pass
+ * - Recurses only into the smaller side and loops on the larger one, bounding
+ *   the stack depth to O(log n)
+ * - Insertion sort for ranges at or below INSERTION_SORT_CUTOFF
+ * - Heapsort fallback once the depth limit of 2 * log2(n) levels is exhausted
+ *
+ * Templated on a metrics policy (see MetricsPolicy.h), the element type and a strict
+ * weak ordering; IntroSort is the comparison-counting int instantiation.
+ */
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicIntroSort {
+private:
+    static constexpr ptrdiff_t INSERTION_SORT_CUTOFF = 16;
+    // State an introSort frame keeps live across its recursive call: the range, its
+    // bounds, the partition bounds and the remaining depth
+    static constexpr size_t FRAME_STATE_BYTES = sizeof(Span<T>) + 4 * sizeof(ptrdiff_t) + sizeof(size_t);
+
+    // Metrics policy collecting comparisons
+    Metrics metrics;
+    // Random number generator for pivot sampling; 64-bit, so one draw covers any position
+    std::random_device rd;
+    std::mt19937_64 gen;
+    // Element ordering
+    Compare compare;
+
+    // Private helper methods
+    bool less(const T& a, const T& b);
+    T medianOfThree(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
+    void partition3(Span<T> arr, ptrdiff_t low, ptrdiff_t high, ptrdiff_t& lt, ptrdiff_t& gt);
+    void insertionSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
+    void siftDown(Span<T> arr, ptrdiff_t low, ptrdiff_t root, ptrdiff_t size);
+    void heapSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
+    void introSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high, size_t depth_limit);
+
+public:
+    // Constructor
+    explicit BasicIntroSort(Compare compare = Compare()) : gen(rd()), compare(compare) {}
+
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<T> arr);
+};
+
+using IntroSort = BasicIntroSort<CountComparisons>;
+
+// Implementation of the methods
+template <typename Metrics, typename T, typename Compare>
+inline bool BasicIntroSort<Metrics, T, Compare>::less(const T& a, const T& b) {
+    metrics.comparison();
+    return compare(a, b);
+}
+
+// Median of three randomly sampled elements; only the pivot value is chosen,
+// the elements stay where they are
+template <typename Metrics, typename T, typename Compare>
+inline T BasicIntroSort<Metrics, T, Compare>::medianOfThree(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
+    std::uniform_int_distribution<ptrdiff_t> distrib(low, high);
+    T a = arr[distrib(gen)];
+    T b = arr[distrib(gen)];
+    T c = arr[distrib(gen)];
+    if (less(a, b)) {
+        if (less(b, c)) return b;
+        return less(a, c) ? c : a;
+    }
+    if (less(a, c)) return a;
+    return less(b, c) ? c : b;
+}
+
+// After the call arr[low..lt-1] < pivot, arr[lt..gt] == pivot and arr[gt+1..high] > pivot
+template <typename Metrics, typename T, typename Compare>
+inline void BasicIntroSort<Metrics, T, Compare>::partition3(Span<T> arr, ptrdiff_t low, ptrdiff_t high, ptrdiff_t& lt, ptrdiff_t& gt) {
+    T pivot = medianOfThree(arr, low, high);
+    ptrdiff_t i = low;
+    lt = low;
+    gt = high;
+
+    while (i <= gt) {
+        if (less(arr[i], pivot)) {
+            std::swap(arr[lt], arr[i]);
+            lt++;
+            i++;
+        } else if (less(pivot, arr[i])) {
+            std::swap(arr[i], arr[gt]);
+            gt--;
+        } else {
+            i++;
+        }
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicIntroSort<Metrics, T, Compare>::insertionSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
+    for (ptrdiff_t i = low + 1; i <= high; i++) {
+        T key = arr[i];
+        ptrdiff_t j = i - 1;
+        while (j >= low && less(key, arr[j])) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicIntroSort<Metrics, T, Compare>::siftDown(Span<T> arr, ptrdiff_t low, ptrdiff_t root, ptrdiff_t size) {
+    while (true) {
+        ptrdiff_t largest = root;
+        ptrdiff_t left = 2 * root + 1;
+        ptrdiff_t right = left + 1;
+        if (left < size && less(arr[low + largest], arr[low + left])) largest = left;
+        if (right < size && less(arr[low + largest], arr[low + right])) largest = right;
+        if (largest == root) {
+            return;
+        }
+        std::swap(arr[low + root], arr[low + largest]);
+        root = largest;
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicIntroSort<Metrics, T, Compare>::heapSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
+    ptrdiff_t size = high - low + 1;
+    for (ptrdiff_t root = size / 2 - 1; root >= 0; root--) {
+        siftDown(arr, low, root, size);
+    }
+    for (ptrdiff_t end = size - 1; end > 0; end--) {
+        std::swap(arr[low], arr[low + end]);
+        siftDown(arr, low, 0, end);
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicIntroSort<Metrics, T, Compare>::introSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high, size_t depth_limit) {
+    while (high - low + 1 > INSERTION_SORT_CUTOFF) {
+        if (depth_limit == 0) {
+            heapSort(arr, low, high);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t lt, gt;
+        partition3(arr, low, high, lt, gt);
+
+        // Recurse into the smaller side, keep looping on the larger one
+        if (lt - low < high - gt) {
+            introSort(arr, low, lt - 1, depth_limit);
+            low = gt + 1;
+        } else {
+            introSort(arr, gt + 1, high, depth_limit);
+            high = lt - 1;
+        }
+    }
+    insertionSort(arr, low, high);
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline AlgorithmResult BasicIntroSort<Metrics, T, Compare>::sortWithMetrics(Span<T> arr) {
+    auto start_time = std::chrono::steady_clock::now();
+    metrics.reset();
+    size_t stack_usage = 0;
+    
+    if (!arr.empty()) {
+        size_t log_n = static_cast<size_t>(std::log2(static_cast<double>(arr.size())));
+        introSort(arr, 0, static_cast<ptrdiff_t>(arr.size()) - 1, 2 * log_n);
+        // Recursion only follows the smaller side, so at most 1 + log2(n) frames are live at once
+        stack_usage = FRAME_STATE_BYTES * (1 + log_n);
+    }
+    
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    
+    return AlgorithmResult::forSorting("IntroSort", sortedView(arr), execution_time, metrics.comparisons(), stack_usage);
+}
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h)
+inline const bool intro_sort_registered = AlgorithmRegistry::add({"intro_sort", "Intro Sort", SORTS,
+    engineFactory<IntroSort>([](IntroSort& sorter, const AlgorithmRequest& request) { return sorter.sortWithMetrics(request.data); })});
+
+#endif // INTROSORT_H
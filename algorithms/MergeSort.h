@@ -3,41 +3,93 @@
 
 #include <vector>
 #include <chrono>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
 #include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "../PageAllocator.h"
+#include "SimdSort.h"
+#include "MetricsPolicy.h"
 
-class MergeSort {
+/**
+ * Strategy used by MergeSort:
+ *   - RECURSIVE: top-down merge sort allocating two temporaries on every merge
+ *   - BUFFERED:  top-down merge sort merging through a single reusable scratch buffer
+ *   - BOTTOM_UP: iterative merge sort ping-ponging between the array and the scratch buffer
+ *
+ * The BUFFERED and BOTTOM_UP modes can additionally use the SimdSort kernels:
+ * ranges of up to SimdSort::MAX_SMALL_SORT elements are sorted by a sorting
+ * network and runs are merged with the vectorized bitonic merge.
+ */
+enum class MergeSortMode {
+    RECURSIVE,
+    BUFFERED,
+    BOTTOM_UP
+};
+
+/**
+ * Stable merge sort templated on a metrics policy (see MetricsPolicy.h), the element
+ * type and a strict weak ordering; MergeSort is the comparison-counting int
+ * instantiation. Elements only need to be copyable.
+ */
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicMergeSort {
 private:
-    // Member variable to count comparisons
-    long long comparisons;
+    // The SIMD kernels sort ints in ascending order only
+    static constexpr bool SIMD_CAPABLE = std::is_same<T, int>::value && std::is_same<Compare, std::less<int>>::value;
+
+    // Metrics policy collecting comparisons
+    Metrics metrics;
+    // Selected merge strategy
+    MergeSortMode mode;
+    // Whether the SIMD leaf sort and merge kernels are used
+    bool simd_kernels;
+    // Element ordering
+    Compare compare;
+    // Scratch buffer shared by every merge, kept across sortWithMetrics calls
+    PlacedVector<T> buffer;
 
     // Private helper methods
-    void merge(std::vector<int>& arr, int l, int m, int r);
-    void sort(std::vector<int>& arr, int l, int r);
+    void merge(Span<T> arr, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r);
+    void sort(Span<T> arr, ptrdiff_t l, ptrdiff_t r);
+    void mergeBuffered(Span<T> arr, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r);
+    void sortBuffered(Span<T> arr, ptrdiff_t l, ptrdiff_t r);
+    void mergeRuns(const T* src, T* dst, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r);
+    void sortBottomUp(Span<T> arr);
 
 public:
-    // Constructor
-    MergeSort() : comparisons(0) {}
+    // Constructor; simd_kernels requires int elements and the default ordering
+    explicit BasicMergeSort(MergeSortMode mode = MergeSortMode::RECURSIVE, bool simd_kernels = false, Compare compare = Compare())
+        : mode(mode), simd_kernels(simd_kernels), compare(compare) {
+        if (simd_kernels && !SIMD_CAPABLE) {
+            throw std::invalid_argument("The SIMD kernels only sort int in ascending order");
+        }
+    }
 
-    // Public interface
-    AlgorithmResult sortWithMetrics(std::vector<int> arr);
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<T> arr);
 };
 
-// Implementation of the methods
-inline void MergeSort::merge(std::vector<int>& arr, int l, int m, int r) {
-    int n1 = m - l + 1;
-    int n2 = r - m;
+using MergeSort = BasicMergeSort<CountComparisons>;
 
-    std::vector<int> L(n1), R(n2);
+// Implementation of the methods
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::merge(Span<T> arr, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r) {
+    ptrdiff_t n1 = m - l + 1;
+    ptrdiff_t n2 = r - m;
 
-    for (int i = 0; i < n1; i++)
-        L[i] = arr[l + i];
-    for (int j = 0; j < n2; j++)
-        R[j] = arr[m + 1 + j];
+    PlacedVector<T> L(arr.begin() + l, arr.begin() + m + 1);
+    PlacedVector<T> R(arr.begin() + m + 1, arr.begin() + r + 1);
 
-    int i = 0, j = 0, k = l;
+    ptrdiff_t i = 0, j = 0, k = l;
     while (i < n1 && j < n2) {
-        comparisons++;
-        if (L[i] <= R[j]) {
+        metrics.comparison();
+        if (!compare(R[j], L[i])) {
             arr[k] = L[i];
             i++;
         } else {
@@ -60,35 +112,183 @@ inline void MergeSort::merge(std::vector<int>& arr, int l, int m, int r) {
     }
 }
 
-inline void MergeSort::sort(std::vector<int>& arr, int l, int r) {
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::sort(Span<T> arr, ptrdiff_t l, ptrdiff_t r) {
     if (l < r) {
-        int m = l + (r - l) / 2;
+        ptrdiff_t m = l + (r - l) / 2;
         sort(arr, l, m);
         sort(arr, m + 1, r);
         merge(arr, l, m, r);
     }
 }
 
-inline AlgorithmResult MergeSort::sortWithMetrics(std::vector<int> arr) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-    
-    // Reset comparison counter
-    comparisons = 0;
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::mergeBuffered(Span<T> arr, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r) {
+    // Only the left run needs to be saved: the right run is consumed in place
+    // and the write cursor can never overtake it.
+    for (ptrdiff_t i = l; i <= m; i++)
+        buffer[i] = arr[i];
+
+    if constexpr (SIMD_CAPABLE) {
+        if (simd_kernels) {
+            uint64_t scalar_comparisons = 0, vector_comparisons = 0;
+            SimdSort::merge(buffer.data() + l, m - l + 1, arr.data() + m + 1, r - m, arr.data() + l, scalar_comparisons, vector_comparisons);
+            metrics.comparison(scalar_comparisons);
+            metrics.vectorComparison(vector_comparisons);
+            return;
+        }
+    }
+
+    ptrdiff_t i = l, j = m + 1, k = l;
+    while (i <= m && j <= r) {
+        metrics.comparison();
+        if (!compare(arr[j], buffer[i])) {
+            arr[k] = buffer[i];
+            i++;
+        } else {
+            arr[k] = arr[j];
+            j++;
+        }
+        k++;
+    }
+
+    while (i <= m) {
+        arr[k] = buffer[i];
+        i++;
+        k++;
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::sortBuffered(Span<T> arr, ptrdiff_t l, ptrdiff_t r) {
+    if constexpr (SIMD_CAPABLE) {
+        if (simd_kernels && r - l + 1 <= SimdSort::MAX_SMALL_SORT) {
+            uint64_t scalar_comparisons = 0, vector_comparisons = 0;
+            SimdSort::sortSmall(arr.data() + l, static_cast<int>(r - l + 1), scalar_comparisons, vector_comparisons);
+            metrics.comparison(scalar_comparisons);
+            metrics.vectorComparison(vector_comparisons);
+            return;
+        }
+    }
+    if (l < r) {
+        ptrdiff_t m = l + (r - l) / 2;
+        sortBuffered(arr, l, m);
+        sortBuffered(arr, m + 1, r);
+        mergeBuffered(arr, l, m, r);
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::mergeRuns(const T* src, T* dst, ptrdiff_t l, ptrdiff_t m, ptrdiff_t r) {
+    if constexpr (SIMD_CAPABLE) {
+        if (simd_kernels) {
+            uint64_t scalar_comparisons = 0, vector_comparisons = 0;
+            SimdSort::merge(src + l, m - l, src + m, r - m, dst + l, scalar_comparisons, vector_comparisons);
+            metrics.comparison(scalar_comparisons);
+            metrics.vectorComparison(vector_comparisons);
+            return;
+        }
+    }
+
+    ptrdiff_t i = l, j = m, k = l;
+    while (i < m && j < r) {
+        metrics.comparison();
+        if (!compare(src[j], src[i])) {
+            dst[k++] = src[i++];
+        } else {
+            dst[k++] = src[j++];
+        }
+    }
+
+    while (i < m)
+        dst[k++] = src[i++];
+    while (j < r)
+        dst[k++] = src[j++];
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline void BasicMergeSort<Metrics, T, Compare>::sortBottomUp(Span<T> arr) {
+    ptrdiff_t n = static_cast<ptrdiff_t>(arr.size());
+    T* src = arr.data();
+    T* dst = buffer.data();
+    ptrdiff_t width = 1;
+
+    if constexpr (SIMD_CAPABLE) {
+        if (simd_kernels) {
+            // Start from blocks already sorted by the sorting network
+            width = SimdSort::MAX_SMALL_SORT;
+            uint64_t scalar_comparisons = 0, vector_comparisons = 0;
+            for (ptrdiff_t l = 0; l < n; l += width) {
+                SimdSort::sortSmall(src + l, static_cast<int>(std::min(width, n - l)), scalar_comparisons, vector_comparisons);
+            }
+            metrics.comparison(scalar_comparisons);
+            metrics.vectorComparison(vector_comparisons);
+        }
+    }
+
+    for (; width < n; width *= 2) {
+        for (ptrdiff_t l = 0; l < n; l += 2 * width) {
+            ptrdiff_t m = (l + width < n) ? l + width : n;
+            ptrdiff_t r = (l + 2 * width < n) ? l + 2 * width : n;
+            mergeRuns(src, dst, l, m, r);
+        }
+        std::swap(src, dst);
+    }
+
+    // After an odd number of passes the sorted data lives in the scratch buffer
+    if (src != arr.data()) {
+        std::copy(buffer.begin(), buffer.begin() + n, arr.begin());
+    }
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline AlgorithmResult BasicMergeSort<Metrics, T, Compare>::sortWithMetrics(Span<T> arr) {
+    auto start_time = std::chrono::steady_clock::now();
     
-    // Calculate initial memory usage (input vector)
-    size_t initial_memory = sizeof(int) * arr.capacity();
+    // Reset comparison counters
+    metrics.reset();
     
     // Execute merge sort
-    sort(arr, 0, arr.size() - 1);
+    if (mode == MergeSortMode::RECURSIVE) {
+        sort(arr, 0, static_cast<ptrdiff_t>(arr.size()) - 1);
+    } else {
+        // Grow the scratch buffer only when a larger input shows up
+        if (buffer.size() < arr.size()) {
+            buffer.resize(arr.size());
+        }
+
+        if (mode == MergeSortMode::BUFFERED) {
+            sortBuffered(arr, 0, static_cast<ptrdiff_t>(arr.size()) - 1);
+        } else {
+            sortBottomUp(arr);
+        }
+    }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
+    auto end_time = std::chrono::steady_clock::now();
     double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
     // Additional memory used by merge sort is the size of the temporary arrays
     // which is O(n) in the worst case
-    size_t additional_memory = sizeof(int) * arr.size();
+    size_t additional_memory = sizeof(T) * arr.size();
     
-    return AlgorithmResult::forSorting("MergeSort", std::move(arr), execution_time, comparisons, additional_memory);
+    AlgorithmResult result = AlgorithmResult::forSorting("MergeSort", sortedView(arr), execution_time, metrics.comparisons(), additional_memory);
+    result.vector_comparisons = metrics.vectorComparisons();
+    return result;
 }
 
-#endif // MERGESORT_H
\ No newline at end of file
+// Engines registered with the benchmark (see AlgorithmRegistry.h); the scratch-buffer
+// modes keep their buffer across calls, so it is allocated once per benchmark thread
+inline bool registerMergeSortEngines() {
+    auto sort = [](auto& sorter, const AlgorithmRequest& request) { return sorter.sortWithMetrics(request.data); };
+    AlgorithmRegistry::add({"merge_sort", "Merge Sort", SORTS, engineFactory<MergeSort>(sort)});
+    // Counters compiled out; the time difference to merge_sort is the cost of the instrumentation
+    AlgorithmRegistry::add({"merge_sort_uncounted", "Merge Sort Uncounted", SORTS, engineFactory<BasicMergeSort<NoMetrics>>(sort)});
+    AlgorithmRegistry::add({"merge_sort_buffered", "Merge Sort Buffered", SORTS, engineFactory<MergeSort>(sort, MergeSortMode::BUFFERED)});
+    AlgorithmRegistry::add({"merge_sort_bottom_up", "Merge Sort Bottom-Up", SORTS, engineFactory<MergeSort>(sort, MergeSortMode::BOTTOM_UP)});
+    AlgorithmRegistry::add({"merge_sort_simd", "Merge Sort SIMD", SORTS, engineFactory<MergeSort>(sort, MergeSortMode::BOTTOM_UP, true)});
+    return true;
+}
+
+inline const bool merge_sort_engines_registered = registerMergeSortEngines();
+
+#endif // MERGESORT_H
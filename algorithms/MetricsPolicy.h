@@ -0,0 +1,56 @@
+#ifndef METRICS_POLICY_H
+#define METRICS_POLICY_H
+
+#include <cstdint>
+
+/**
+ * Compile-time metric policies for the algorithm templates.
+ *
+ * Algorithms call the hooks unconditionally. With NoMetrics every hook is an
+ * empty inline function, so an uninstrumented instantiation compiles down to
+ * the bare algorithm and its timings carry no counting overhead.
+ *   - NoMetrics: counts nothing
+ *   - CountComparisons: scalar and vector comparisons
+ *   - CountComparisonsAndSwaps: comparisons plus element swaps
+ */
+struct NoMetrics {
+    void reset() {}
+    void comparison(uint64_t = 1) {}
+    void vectorComparison(uint64_t = 1) {}
+    void swap(uint64_t = 1) {}
+
+    uint64_t comparisons() const { return 0; }
+    uint64_t vectorComparisons() const { return 0; }
+    uint64_t swaps() const { return 0; }
+};
+
+struct CountComparisons {
+    uint64_t comparison_count = 0;
+    uint64_t vector_comparison_count = 0;
+
+    void reset() {
+        comparison_count = 0;
+        vector_comparison_count = 0;
+    }
+    void comparison(uint64_t count = 1) { comparison_count += count; }
+    void vectorComparison(uint64_t count = 1) { vector_comparison_count += count; }
+    void swap(uint64_t = 1) {}
+
+    uint64_t comparisons() const { return comparison_count; }
+    uint64_t vectorComparisons() const { return vector_comparison_count; }
+    uint64_t swaps() const { return 0; }
+};
+
+struct CountComparisonsAndSwaps : CountComparisons {
+    uint64_t swap_count = 0;
+
+    void reset() {
+        CountComparisons::reset();
+        swap_count = 0;
+    }
+    void swap(uint64_t count = 1) { swap_count += count; }
+
+    uint64_t swaps() const { return swap_count; }
+};
+
+#endif // METRICS_POLICY_H
@@ -0,0 +1,132 @@
+#ifndef MULTI_SELECT_H
+#define MULTI_SELECT_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "Partition.h"
+#include "MetricsPolicy.h"
+
+/**
+ * @class MultiSelect
+ * @brief Finds several order statistics of the same array in one pass.
+ *
+ * Works like QuickSelect, but a segment is kept as long as any requested rank
+ * still falls inside it: after each block partition the sorted list of ranks
+ * is split at the pivot position and both sides are pushed on an explicit
+ * stack if they still hold ranks. Finding m ranks costs O(n log m) expected
+ * instead of m independent O(n) selections.
+ */
+class MultiSelect {
+private:
+    static constexpr int INSERTION_SORT_CUTOFF = 16;
+
+    // A range of the array together with the range of requested ranks inside it
+    struct Segment {
+        ptrdiff_t left;
+        ptrdiff_t right;
+        size_t first_rank;
+        size_t last_rank;  // exclusive
+    };
+
+    std::mt19937_64 gen;
+    CountComparisons metrics;
+    size_t peak_segments;
+
+    void insertionSort(Span<int> data, ptrdiff_t left, ptrdiff_t right) {
+        for (ptrdiff_t i = left + 1; i <= right; i++) {
+            int key = data[i];
+            ptrdiff_t j = i - 1;
+            while (j >= left) {
+                metrics.comparison();
+                if (data[j] <= key) break;
+                data[j + 1] = data[j];
+                j--;
+            }
+            data[j + 1] = key;
+        }
+    }
+
+public:
+    explicit MultiSelect(uint64_t seed = std::random_device{}()) : gen(seed), peak_segments(0) {}
+
+    /**
+     * @brief Finds the elements of rank ks[0], ks[1], ... with performance metrics.
+     *
+     * @param data The input array, reordered in place
+     * @param ks The 0-based ranks to find, sorted in increasing order
+     * @return AlgorithmResult whose values hold one value per requested rank
+     */
+    AlgorithmResult selectWithMetrics(Span<int> data, const std::vector<size_t>& ks) {
+        auto start_time = std::chrono::steady_clock::now();
+        metrics.reset();
+        peak_segments = 0;
+
+        for (size_t i = 0; i < ks.size(); i++) {
+            if (ks[i] >= data.size())
+                throw std::out_of_range("k is out of bounds");
+            if (i > 0 && ks[i] < ks[i - 1])
+                throw std::invalid_argument("ranks must be sorted");
+        }
+
+        std::vector<Segment> stack;
+        if (!ks.empty()) {
+            stack.push_back({0, static_cast<ptrdiff_t>(data.size()) - 1, 0, ks.size()});
+        }
+
+        while (!stack.empty()) {
+            peak_segments = std::max(peak_segments, stack.size());
+            Segment segment = stack.back();
+            stack.pop_back();
+
+            if (segment.right - segment.left + 1 <= INSERTION_SORT_CUTOFF) {
+                insertionSort(data, segment.left, segment.right);
+                continue;
+            }
+
+            std::uniform_int_distribution<ptrdiff_t> distrib(segment.left, segment.right);
+            std::swap(data[distrib(gen)], data[segment.right]);
+            ptrdiff_t pivot_index = BlockPartition::partition(data, segment.left, segment.right, metrics);
+            size_t pivot_rank = static_cast<size_t>(pivot_index);
+
+            // Ranks below the pivot go left, ranks past it go right, the pivot itself is settled
+            auto first = ks.begin() + segment.first_rank;
+            auto last = ks.begin() + segment.last_rank;
+            size_t split_low = std::lower_bound(first, last, pivot_rank) - ks.begin();
+            size_t split_high = std::upper_bound(first, last, pivot_rank) - ks.begin();
+
+            if (split_low > segment.first_rank) {
+                stack.push_back({segment.left, pivot_index - 1, segment.first_rank, split_low});
+            }
+            if (split_high < segment.last_rank) {
+                stack.push_back({pivot_index + 1, segment.right, split_high, segment.last_rank});
+            }
+        }
+
+        std::vector<int> values;
+        values.reserve(ks.size());
+        for (size_t k : ks) {
+            values.push_back(data[k]);
+        }
+
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        size_t memory_used = peak_segments * sizeof(Segment) + values.capacity() * sizeof(int);
+
+        return AlgorithmResult::forMultiSelection("MultiSelect", std::move(values), execution_time, metrics.comparisons(), memory_used);
+    }
+};
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h)
+inline const bool multi_select_registered = AlgorithmRegistry::add({"multi_select", "MultiSelect", SELECTS_MANY,
+    engineFactory<MultiSelect>([](MultiSelect& selector, const AlgorithmRequest& request) { return selector.selectWithMetrics(request.data, *request.ranks); })});
+
+#endif // MULTI_SELECT_H
@@ -0,0 +1,406 @@
+#ifndef NATURAL_MERGE_SORT_H
+#define NATURAL_MERGE_SORT_H
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "../PageAllocator.h"
+#include "MetricsPolicy.h"
+
+/**
+ * @class BasicNaturalMergeSort
+ * @brief Stable run-adaptive merge sort in the style of TimSort, merging with the Powersort policy.
+ *
+ * The input is scanned left to right for natural runs: non-descending runs are
+ * taken as they are and strictly descending ones are reversed in place (strictness
+ * keeps the sort stable). Runs shorter than minRun are extended to minRun elements
+ * by binary insertion. Adjacent runs are merged in the order given by the Powersort
+ * node powers, which keeps the merge tree within a few comparisons per element of
+ * optimal for the run lengths found. Each merge first trims the prefix of the left
+ * run and the suffix of the right run that are already in place, copies the shorter
+ * remaining run to the scratch buffer and switches to galloping (exponential search
+ * and block copies) once one side keeps winning.
+ *
+ * On sorted and reverse-sorted inputs this is a single scan, n - 1 comparisons;
+ * on inputs made of few long runs it is O(n log r) for r runs, and on random inputs
+ * it stays within a few percent of a plain merge sort.
+ *
+ * @tparam Metrics Instrumentation policy (see MetricsPolicy.h)
+ * @tparam T Element type, only needs to be copyable
+ * @tparam Compare Strict weak ordering of the elements
+ */
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicNaturalMergeSort {
+private:
+    // Consecutive wins of one side after which a merge starts galloping
+    static constexpr ptrdiff_t MIN_GALLOP = 7;
+
+    // A sorted run on the merge stack; power is the Powersort power of its right boundary
+    struct Run {
+        ptrdiff_t start;
+        ptrdiff_t length;
+        int power;
+    };
+
+    // Metrics policy collecting comparisons
+    Metrics metrics;
+    // Element ordering
+    Compare compare;
+    // Scratch buffer holding the shorter run of a merge, kept across sortWithMetrics calls
+    PlacedVector<T> buffer;
+    // Pending runs, at most O(log n) deep
+    std::vector<Run> runs;
+    // Galloping threshold of the current sort, adapted while merging
+    ptrdiff_t min_gallop = MIN_GALLOP;
+    // Largest number of elements copied to the scratch buffer by the current sort
+    size_t peak_buffer = 0;
+
+    // Private helper methods
+    static ptrdiff_t minRun(ptrdiff_t n);
+    static int nodePower(ptrdiff_t start1, ptrdiff_t length1, ptrdiff_t length2, ptrdiff_t n);
+    ptrdiff_t countRunAndMakeAscending(T* arr, ptrdiff_t lo, ptrdiff_t hi);
+    void binaryInsertionSort(T* arr, ptrdiff_t lo, ptrdiff_t hi, ptrdiff_t start);
+    template <typename Pred>
+    ptrdiff_t gallop(const T* base, ptrdiff_t length, bool from_end, Pred goes_before);
+    void mergeAt(T* arr, const Run& left, const Run& right);
+    void mergeLo(T* arr, ptrdiff_t lo, ptrdiff_t mid, ptrdiff_t hi);
+    void mergeHi(T* arr, ptrdiff_t lo, ptrdiff_t mid, ptrdiff_t hi);
+
+public:
+    explicit BasicNaturalMergeSort(Compare compare = Compare()) : compare(compare) {}
+
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<T> arr);
+};
+
+using NaturalMergeSort = BasicNaturalMergeSort<CountComparisons>;
+
+// Implementation of the methods
+
+// TimSort's minimum run length: n / minRun is a power of two or just below one,
+// with minRun in [32, 64] (or n itself for small inputs)
+template <typename Metrics, typename T, typename Compare>
+inline ptrdiff_t BasicNaturalMergeSort<Metrics, T, Compare>::minRun(ptrdiff_t n) {
+    ptrdiff_t low_bits = 0;
+    while (n >= 64) {
+        low_bits |= n & 1;
+        n >>= 1;
+    }
+    return n + low_bits;
+}
+
+// Depth of the boundary between two adjacent runs in the ideal merge tree: the
+// position of the first bit where the midpoints of the runs, scaled to [0, 1), differ
+template <typename Metrics, typename T, typename Compare>
+inline int BasicNaturalMergeSort<Metrics, T, Compare>::nodePower(ptrdiff_t start1, ptrdiff_t length1, ptrdiff_t length2, ptrdiff_t n) {
+    int power = 0;
+    ptrdiff_t a = 2 * start1 + length1;  // twice the first midpoint
+    ptrdiff_t b = a + length1 + length2; // twice the second midpoint
+    for (;;) {
+        ++power;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline ptrdiff_t BasicNaturalMergeSort<Metrics, T, Compare>::countRunAndMakeAscending(T* arr, ptrdiff_t lo, ptrdiff_t hi) {
+    ptrdiff_t end = lo + 1;
+    if (end == hi) return 1;
+
+    metrics.comparison();
+    if (compare(arr[end], arr[lo])) {
+        end++;
+        while (end < hi) {
+            metrics.comparison();
+            if (!compare(arr[end], arr[end - 1])) break;
+            end++;
+        }
+        std::reverse(arr + lo, arr + end);
+    } else {
+        end++;
+        while (end < hi) {
+            metrics.comparison();
+            if (compare(arr[end], arr[end - 1])) break;
+            end++;
+        }
+    }
+    return end - lo;
+}
+
+// Sorts arr[lo, hi) given that arr[lo, start) is already sorted
+template <typename Metrics, typename T, typename Compare>
+inline void BasicNaturalMergeSort<Metrics, T, Compare>::binaryInsertionSort(T* arr, ptrdiff_t lo, ptrdiff_t hi, ptrdiff_t start) {
+    for (ptrdiff_t i = start; i < hi; i++) {
+        T pivot = arr[i];
+        // Insert after the equal elements to stay stable
+        ptrdiff_t left = lo, right = i;
+        while (left < right) {
+            ptrdiff_t mid = left + (right - left) / 2;
+            metrics.comparison();
+            if (compare(pivot, arr[mid])) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        std::move_backward(arr + left, arr + i, arr + i + 1);
+        arr[left] = pivot;
+    }
+}
+
+// Number of leading elements of base[0, length) for which goes_before holds (it must
+// hold for a prefix). Probes 1, 2, 4, ... elements away from the front (or the back)
+// before the binary search, so the cost grows with the log of the distance from
+// that end rather than with the log of length
+template <typename Metrics, typename T, typename Compare>
+template <typename Pred>
+inline ptrdiff_t BasicNaturalMergeSort<Metrics, T, Compare>::gallop(const T* base, ptrdiff_t length, bool from_end, Pred goes_before) {
+    ptrdiff_t lo = 0, hi = length;
+    if (!from_end) {
+        for (ptrdiff_t probe = 0; probe < length; probe = 2 * probe + 1) {
+            metrics.comparison();
+            if (!goes_before(base[probe])) {
+                hi = probe;
+                break;
+            }
+            lo = probe + 1;
+        }
+    } else {
+        for (ptrdiff_t offset = 1; offset <= length; offset *= 2) {
+            ptrdiff_t probe = length - offset;
+            metrics.comparison();
+            if (goes_before(base[probe])) {
+                lo = probe + 1;
+                break;
+            }
+            hi = probe;
+        }
+    }
+
+    while (lo < hi) {
+        ptrdiff_t mid = lo + (hi - lo) / 2;
+        metrics.comparison();
+        if (goes_before(base[mid])) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Merges two adjacent runs, left directly before right
+template <typename Metrics, typename T, typename Compare>
+inline void BasicNaturalMergeSort<Metrics, T, Compare>::mergeAt(T* arr, const Run& left, const Run& right) {
+    ptrdiff_t lo = left.start;
+    ptrdiff_t mid = right.start;
+    ptrdiff_t hi = right.start + right.length;
+
+    // Left elements not greater than the first right element are already in place
+    const T& first_right = arr[mid];
+    lo += gallop(arr + lo, mid - lo, false, [&](const T& x) { return !compare(first_right, x); });
+    if (lo == mid) return;
+
+    // So are right elements not less than the last left element
+    const T& last_left = arr[mid - 1];
+    hi = mid + gallop(arr + mid, hi - mid, true, [&](const T& x) { return compare(x, last_left); });
+
+    if (mid - lo <= hi - mid) {
+        mergeLo(arr, lo, mid, hi);
+    } else {
+        mergeHi(arr, lo, mid, hi);
+    }
+}
+
+// Merges front to back with the left run in the scratch buffer
+template <typename Metrics, typename T, typename Compare>
+inline void BasicNaturalMergeSort<Metrics, T, Compare>::mergeLo(T* arr, ptrdiff_t lo, ptrdiff_t mid, ptrdiff_t hi) {
+    ptrdiff_t n1 = mid - lo, n2 = hi - mid;
+    std::copy(arr + lo, arr + mid, buffer.begin());
+    peak_buffer = std::max(peak_buffer, static_cast<size_t>(n1));
+
+    const T* left = buffer.data();
+    const T* right = arr + mid;
+    T* out = arr + lo;
+    ptrdiff_t i = 0, j = 0;
+
+    while (i < n1 && j < n2) {
+        // One element at a time until a side wins min_gallop times in a row
+        ptrdiff_t left_wins = 0, right_wins = 0;
+        while (i < n1 && j < n2 && left_wins < min_gallop && right_wins < min_gallop) {
+            metrics.comparison();
+            if (compare(right[j], left[i])) {
+                *out++ = right[j++];
+                right_wins++;
+                left_wins = 0;
+            } else {
+                *out++ = left[i++];
+                left_wins++;
+                right_wins = 0;
+            }
+        }
+
+        // Galloping: copy whole blocks while they stay long
+        while (i < n1 && j < n2) {
+            const T& next_right = right[j];
+            ptrdiff_t from_left = gallop(left + i, n1 - i, false, [&](const T& x) { return !compare(next_right, x); });
+            out = std::copy(left + i, left + i + from_left, out);
+            i += from_left;
+            if (i == n1) break;
+
+            const T& next_left = left[i];
+            ptrdiff_t from_right = gallop(right + j, n2 - j, false, [&](const T& x) { return compare(x, next_left); });
+            out = std::copy(right + j, right + j + from_right, out);
+            j += from_right;
+
+            if (from_left < MIN_GALLOP && from_right < MIN_GALLOP) {
+                min_gallop++;
+                break;
+            }
+            if (min_gallop > 1) min_gallop--;
+        }
+    }
+
+    // What is left of the right run is already in place
+    std::copy(left + i, left + n1, out);
+}
+
+// Merges back to front with the right run in the scratch buffer
+template <typename Metrics, typename T, typename Compare>
+inline void BasicNaturalMergeSort<Metrics, T, Compare>::mergeHi(T* arr, ptrdiff_t lo, ptrdiff_t mid, ptrdiff_t hi) {
+    ptrdiff_t n1 = mid - lo, n2 = hi - mid;
+    std::copy(arr + mid, arr + hi, buffer.begin());
+    peak_buffer = std::max(peak_buffer, static_cast<size_t>(n2));
+
+    T* left = arr + lo;
+    const T* right = buffer.data();
+    T* out = arr + hi;
+    ptrdiff_t i = n1, j = n2;
+
+    while (i > 0 && j > 0) {
+        ptrdiff_t left_wins = 0, right_wins = 0;
+        while (i > 0 && j > 0 && left_wins < min_gallop && right_wins < min_gallop) {
+            metrics.comparison();
+            if (compare(right[j - 1], left[i - 1])) {
+                *--out = left[--i];
+                left_wins++;
+                right_wins = 0;
+            } else {
+                *--out = right[--j];
+                right_wins++;
+                left_wins = 0;
+            }
+        }
+
+        while (i > 0 && j > 0) {
+            // Right elements not less than the last left element go after it
+            const T& last_left = left[i - 1];
+            ptrdiff_t keep_right = gallop(right, j, true, [&](const T& x) { return compare(x, last_left); });
+            ptrdiff_t from_right = j - keep_right;
+            out = std::copy_backward(right + keep_right, right + j, out);
+            j = keep_right;
+            if (j == 0) break;
+
+            // Left elements greater than the last right element go after it
+            const T& last_right = right[j - 1];
+            ptrdiff_t keep_left = gallop(left, i, true, [&](const T& x) { return !compare(last_right, x); });
+            ptrdiff_t from_left = i - keep_left;
+            out = std::move_backward(left + keep_left, left + i, out);
+            i = keep_left;
+
+            if (from_left < MIN_GALLOP && from_right < MIN_GALLOP) {
+                min_gallop++;
+                break;
+            }
+            if (min_gallop > 1) min_gallop--;
+        }
+    }
+
+    // What is left of the left run is already in place
+    std::copy(right, right + j, arr + lo);
+}
+
+template <typename Metrics, typename T, typename Compare>
+inline AlgorithmResult BasicNaturalMergeSort<Metrics, T, Compare>::sortWithMetrics(Span<T> arr) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    metrics.reset();
+    min_gallop = MIN_GALLOP;
+    peak_buffer = 0;
+    runs.clear();
+
+    ptrdiff_t n = static_cast<ptrdiff_t>(arr.size());
+    T* data = arr.data();
+    if (n > 1) {
+        // A merge never buffers more than the shorter of its two runs
+        if (buffer.size() < arr.size() / 2) {
+            buffer.resize(arr.size() / 2);
+        }
+
+        ptrdiff_t min_run = minRun(n);
+        Run current{0, 0, 0};
+        for (ptrdiff_t lo = 0; lo < n;) {
+            ptrdiff_t length = countRunAndMakeAscending(data, lo, n);
+            if (length < min_run) {
+                ptrdiff_t forced = std::min(min_run, n - lo);
+                binaryInsertionSort(data, lo, lo + forced, lo + length);
+                length = forced;
+            }
+            Run next{lo, length, 0};
+            lo += length;
+
+            if (current.length == 0) {
+                current = next;
+                continue;
+            }
+
+            // Merge every pending run deeper in the tree than the new boundary
+            int power = nodePower(current.start, current.length, next.length, n);
+            while (!runs.empty() && runs.back().power > power) {
+                mergeAt(data, runs.back(), current);
+                current = Run{runs.back().start, runs.back().length + current.length, 0};
+                runs.pop_back();
+            }
+            runs.push_back(Run{current.start, current.length, power});
+            current = next;
+        }
+
+        while (!runs.empty()) {
+            mergeAt(data, runs.back(), current);
+            current = Run{runs.back().start, runs.back().length + current.length, 0};
+            runs.pop_back();
+        }
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+    // The scratch space actually used: nothing on a single run, at most n / 2 elements
+    size_t additional_memory = sizeof(T) * peak_buffer;
+
+    return AlgorithmResult::forSorting("NaturalMergeSort", sortedView(arr), execution_time, metrics.comparisons(), additional_memory);
+}
+
+// Engines registered with the benchmark (see AlgorithmRegistry.h)
+inline bool registerNaturalMergeSortEngines() {
+    auto sort = [](auto& sorter, const AlgorithmRequest& request) { return sorter.sortWithMetrics(request.data); };
+    AlgorithmRegistry::add({"natural_merge_sort", "Natural Merge Sort", SORTS, engineFactory<NaturalMergeSort>(sort)});
+    return true;
+}
+
+inline const bool natural_merge_sort_engines_registered = registerNaturalMergeSortEngines();
+
+#endif // NATURAL_MERGE_SORT_H
@@ -0,0 +1,184 @@
+#ifndef PARALLEL_MERGESORT_H
+#define PARALLEL_MERGESORT_H
+
+#include <vector>
+#include <cstddef>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "../PageAllocator.h"
+#include "../ThreadPool.h"
+
+/**
+ * @class ParallelMergeSort
+ * @brief Fork-join merge sort running on a work-stealing ThreadPool.
+ *
+ * The recursion of MergeSort::sort is split into tasks until a range drops below
+ * the sequential cutoff. Merges are parallel too: the larger run is split at its
+ * middle element, the matching split point of the other run is found by binary
+ * search, and both halves are merged as independent tasks. Data ping-pongs
+ * between the input and a scratch buffer kept across sortWithMetrics calls.
+ */
+class ParallelMergeSort {
+private:
+    // Ranges at or below these sizes are handled by a single thread
+    static constexpr int SORT_CUTOFF = 8192;
+    static constexpr int MERGE_CUTOFF = 8192;
+
+    ThreadPool& pool;
+    std::atomic<uint64_t> comparisons;
+    PlacedVector<int> buffer;
+
+    // Private helper methods
+    void sequentialMerge(const int* src, ptrdiff_t l1, ptrdiff_t r1, ptrdiff_t l2, ptrdiff_t r2, int* dst, ptrdiff_t d, uint64_t& local_comparisons);
+    void parallelMerge(const int* src, ptrdiff_t l1, ptrdiff_t r1, ptrdiff_t l2, ptrdiff_t r2, int* dst, ptrdiff_t d);
+    void sequentialSort(int* data, int* scratch, ptrdiff_t l, ptrdiff_t r, uint64_t& local_comparisons);
+    void sort(int* data, int* scratch, ptrdiff_t l, ptrdiff_t r, bool into_scratch);
+
+public:
+    // Constructor
+    explicit ParallelMergeSort(ThreadPool& pool) : pool(pool), comparisons(0) {}
+
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<int> arr);
+};
+
+// Implementation of the methods
+
+// Merges src[l1, r1) and src[l2, r2) into dst starting at d
+inline void ParallelMergeSort::sequentialMerge(const int* src, ptrdiff_t l1, ptrdiff_t r1, ptrdiff_t l2, ptrdiff_t r2, int* dst, ptrdiff_t d, uint64_t& local_comparisons) {
+    while (l1 < r1 && l2 < r2) {
+        local_comparisons++;
+        if (src[l1] <= src[l2]) {
+            dst[d++] = src[l1++];
+        } else {
+            dst[d++] = src[l2++];
+        }
+    }
+
+    while (l1 < r1)
+        dst[d++] = src[l1++];
+    while (l2 < r2)
+        dst[d++] = src[l2++];
+}
+
+inline void ParallelMergeSort::parallelMerge(const int* src, ptrdiff_t l1, ptrdiff_t r1, ptrdiff_t l2, ptrdiff_t r2, int* dst, ptrdiff_t d) {
+    ptrdiff_t n1 = r1 - l1;
+    ptrdiff_t n2 = r2 - l2;
+    uint64_t local_comparisons = 0;
+
+    if (n1 + n2 <= MERGE_CUTOFF) {
+        sequentialMerge(src, l1, r1, l2, r2, dst, d, local_comparisons);
+        comparisons.fetch_add(local_comparisons, std::memory_order_relaxed);
+        return;
+    }
+
+    // Split the larger run at its middle and find the stable split of the other run
+    ptrdiff_t m1, m2;
+    auto counting_less = [&local_comparisons](int a, int b) {
+        local_comparisons++;
+        return a < b;
+    };
+    if (n1 >= n2) {
+        m1 = l1 + n1 / 2;
+        m2 = static_cast<ptrdiff_t>(std::lower_bound(src + l2, src + r2, src[m1], counting_less) - src);
+    } else {
+        m2 = l2 + n2 / 2;
+        m1 = static_cast<ptrdiff_t>(std::upper_bound(src + l1, src + r1, src[m2], counting_less) - src);
+    }
+    comparisons.fetch_add(local_comparisons, std::memory_order_relaxed);
+
+    ptrdiff_t split = d + (m1 - l1) + (m2 - l2);
+    TaskGroup group(pool);
+    group.run([=] { parallelMerge(src, l1, m1, l2, m2, dst, d); });
+    parallelMerge(src, m1, r1, m2, r2, dst, split);
+    group.wait();
+}
+
+// Sorts data[l, r) in place using scratch[l, r) as temporary storage
+inline void ParallelMergeSort::sequentialSort(int* data, int* scratch, ptrdiff_t l, ptrdiff_t r, uint64_t& local_comparisons) {
+    if (r - l < 2) {
+        return;
+    }
+    ptrdiff_t m = l + (r - l) / 2;
+    sequentialSort(data, scratch, l, m, local_comparisons);
+    sequentialSort(data, scratch, m, r, local_comparisons);
+    std::copy(data + l, data + m, scratch + l);
+    // Merge the saved left run with the right run still in place
+    ptrdiff_t i = l, j = m, k = l;
+    while (i < m && j < r) {
+        local_comparisons++;
+        if (scratch[i] <= data[j]) {
+            data[k++] = scratch[i++];
+        } else {
+            data[k++] = data[j++];
+        }
+    }
+    while (i < m)
+        data[k++] = scratch[i++];
+}
+
+// Sorts data[l, r); the result ends up in scratch when into_scratch is set, in data otherwise
+inline void ParallelMergeSort::sort(int* data, int* scratch, ptrdiff_t l, ptrdiff_t r, bool into_scratch) {
+    if (r - l <= SORT_CUTOFF) {
+        uint64_t local_comparisons = 0;
+        sequentialSort(data, scratch, l, r, local_comparisons);
+        comparisons.fetch_add(local_comparisons, std::memory_order_relaxed);
+        if (into_scratch) {
+            std::copy(data + l, data + r, scratch + l);
+        }
+        return;
+    }
+
+    ptrdiff_t m = l + (r - l) / 2;
+    {
+        // Children leave their output in the opposite array so the merge lands in the target
+        TaskGroup group(pool);
+        group.run([=] { sort(data, scratch, l, m, !into_scratch); });
+        sort(data, scratch, m, r, !into_scratch);
+        group.wait();
+    }
+
+    if (into_scratch) {
+        parallelMerge(data, l, m, m, r, scratch, l);
+    } else {
+        parallelMerge(scratch, l, m, m, r, data, l);
+    }
+}
+
+inline AlgorithmResult ParallelMergeSort::sortWithMetrics(Span<int> arr) {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    // Reset comparison counter
+    comparisons = 0;
+    
+    // Grow the scratch buffer only when a larger input shows up
+    if (buffer.size() < arr.size()) {
+        buffer.resize(arr.size());
+    }
+    
+    // Execute parallel merge sort
+    sort(arr.data(), buffer.data(), 0, static_cast<ptrdiff_t>(arr.size()), false);
+    
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    
+    // Additional memory is the shared scratch buffer
+    size_t additional_memory = sizeof(int) * arr.size();
+    
+    return AlgorithmResult::forSorting("ParallelMergeSort", arr, execution_time, comparisons.load(), additional_memory);
+}
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h): one pool and sorter
+// per thread count, compared against the sequential buffered merge sort
+inline const bool parallel_merge_sort_registered = AlgorithmRegistry::add({"parallel_merge_sort", "Parallel Merge Sort", SORTS | PARALLEL,
+    [](size_t threads) -> AlgorithmRunner {
+        auto pool = std::make_shared<ThreadPool>(threads);
+        auto sorter = std::make_shared<ParallelMergeSort>(*pool);
+        return [pool, sorter](const AlgorithmRequest& request) { return sorter->sortWithMetrics(request.data); };
+    }, -1.0, 0.0, "merge_sort_buffered"});
+
+#endif // PARALLEL_MERGESORT_H
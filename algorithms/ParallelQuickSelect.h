@@ -0,0 +1,244 @@
+#ifndef PARALLEL_QUICK_SELECT_H
+#define PARALLEL_QUICK_SELECT_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "../PageAllocator.h"
+#include "../ThreadPool.h"
+#include "QuickSelect.h"
+
+/**
+ * @class ParallelQuickSelect
+ * @brief Selection that narrows the input with parallel sample-based partitioning rounds.
+ *
+ * Each round draws a random sample of the active range, sorts it and takes two
+ * pivots a few sample ranks below and above the estimated position of k, so the
+ * element of rank k almost always lies between them. The active range is cut into
+ * one block per thread: every thread counts how many of its elements fall below,
+ * between and above the pivots, a prefix sum over the counts of the bucket holding
+ * k gives every block its output offset, and the threads scatter only that bucket
+ * into a scratch buffer, which becomes the next active range. A round reads the
+ * range twice and writes a small fraction of it, so it runs at memory bandwidth
+ * on every core. Once the range fits in cache it is finished by a sequential block
+ * QuickSelect on the calling thread.
+ *
+ * The input is only read; candidates ping-pong between two scratch buffers that
+ * are kept across calls and only grow.
+ */
+class ParallelQuickSelect {
+private:
+    // Ranges at or below this size (256 KiB of ints) are finished by a single thread
+    static constexpr ptrdiff_t SEQUENTIAL_CUTOFF = 1 << 16;
+    // Sample drawn every round and how many sample ranks the pivots lie from the estimate;
+    // the middle bucket keeps about 2 * SAMPLE_GAP / SAMPLE_SIZE of the range
+    static constexpr ptrdiff_t SAMPLE_SIZE = 4096;
+    static constexpr ptrdiff_t SAMPLE_GAP = 128;
+
+    enum Bucket { LESS, MIDDLE, GREATER };
+
+    // Per-block counters, padded so threads do not share cache lines
+    struct alignas(64) BlockCounts {
+        ptrdiff_t count[3];
+        uint64_t comparisons;
+    };
+
+    ThreadPool& pool;
+    std::mt19937_64 gen{std::random_device{}()};
+    std::vector<int> sample;
+    PlacedVector<int> candidates[2];
+    std::vector<BlockCounts> blocks;
+    QuickSelect sequential{PartitionScheme::BLOCK};
+    uint64_t comparisons = 0;
+    // Largest use of each candidate buffer in the current call
+    size_t peak_candidates[2] = {0, 0};
+
+    // Bucket of element, computed without branches: random data around the pivots
+    // would mispredict about every other branch
+    static Bucket classify(int element, int low_pivot, int high_pivot) {
+        return static_cast<Bucket>((element >= low_pivot) + (element > high_pivot));
+    }
+
+    // Private helper methods
+    template <typename Body>
+    void forEachBlock(ptrdiff_t length, Body body);
+    void choosePivots(const int* active, ptrdiff_t length, size_t k, int& low_pivot, int& high_pivot);
+
+public:
+    // Constructor
+    explicit ParallelQuickSelect(ThreadPool& pool) : pool(pool) {}
+
+    /**
+     * @brief Finds the k-th smallest element of data.
+     *
+     * @param data The input array, left untouched
+     * @param k The position of the element to find (0-based index)
+     * @return AlgorithmResult with the element and the comparisons of every thread
+     */
+    AlgorithmResult selectWithMetrics(Span<const int> data, size_t k);
+};
+
+// Implementation of the methods
+
+// Runs body(block, begin, end) over one contiguous block of [0, length) per pool thread
+template <typename Body>
+inline void ParallelQuickSelect::forEachBlock(ptrdiff_t length, Body body) {
+    ptrdiff_t block_count = static_cast<ptrdiff_t>(blocks.size());
+    TaskGroup group(pool);
+    for (ptrdiff_t block = 1; block < block_count; block++) {
+        group.run([=] { body(block, length * block / block_count, length * (block + 1) / block_count); });
+    }
+    body(0, 0, length / block_count);
+    group.wait();
+}
+
+inline void ParallelQuickSelect::choosePivots(const int* active, ptrdiff_t length, size_t k, int& low_pivot, int& high_pivot) {
+    sample.resize(SAMPLE_SIZE);
+    std::uniform_int_distribution<ptrdiff_t> position(0, length - 1);
+    for (int& element : sample) {
+        element = active[position(gen)];
+    }
+    std::sort(sample.begin(), sample.end(), [this](int a, int b) {
+        comparisons++;
+        return a < b;
+    });
+
+    ptrdiff_t estimate = static_cast<ptrdiff_t>(static_cast<double>(k) * SAMPLE_SIZE / length);
+    low_pivot = sample[std::max<ptrdiff_t>(0, estimate - SAMPLE_GAP)];
+    high_pivot = sample[std::min<ptrdiff_t>(SAMPLE_SIZE - 1, estimate + SAMPLE_GAP)];
+}
+
+inline AlgorithmResult ParallelQuickSelect::selectWithMetrics(Span<const int> data, size_t k) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    comparisons = 0;
+    peak_candidates[0] = peak_candidates[1] = 0;
+    blocks.resize(pool.size());
+
+    const int* active = data.data();
+    // The active range once it has moved to a candidate buffer
+    int* narrowed = nullptr;
+    ptrdiff_t length = static_cast<ptrdiff_t>(data.size());
+    size_t target = 0;
+    bool single_pivot = false;
+    bool found = false;
+    int result = 0;
+
+    while (length > SEQUENTIAL_CUTOFF) {
+        int low_pivot, high_pivot;
+        choosePivots(active, length, k, low_pivot, high_pivot);
+        // Three-way split around one value after a round that kept the whole range
+        if (single_pivot) high_pivot = low_pivot;
+
+        forEachBlock(length, [&](ptrdiff_t block, ptrdiff_t begin, ptrdiff_t end) {
+            BlockCounts counts = {{0, 0, 0}, 2 * static_cast<uint64_t>(end - begin)};
+            for (ptrdiff_t i = begin; i < end; i++) {
+                counts.count[classify(active[i], low_pivot, high_pivot)]++;
+            }
+            blocks[block] = counts;
+        });
+
+        ptrdiff_t totals[3] = {0, 0, 0};
+        for (const BlockCounts& counts : blocks) {
+            comparisons += counts.comparisons;
+            for (int bucket = LESS; bucket <= GREATER; bucket++) totals[bucket] += counts.count[bucket];
+        }
+
+        Bucket bucket;
+        if (k < static_cast<size_t>(totals[LESS])) {
+            bucket = LESS;
+        } else if (k < static_cast<size_t>(totals[LESS] + totals[MIDDLE])) {
+            bucket = MIDDLE;
+            if (low_pivot == high_pivot) {
+                // Every element of the bucket equals the pivot
+                result = low_pivot;
+                found = true;
+                break;
+            }
+            if (totals[MIDDLE] == length) {
+                // Both pivots bracket every element (few distinct values): split on one next round
+                single_pivot = true;
+                continue;
+            }
+            k -= totals[LESS];
+        } else {
+            bucket = GREATER;
+            k -= totals[LESS] + totals[MIDDLE];
+        }
+        single_pivot = false;
+
+        // Exclusive prefix sum of the bucket's per-block counts gives each block its output offset
+        ptrdiff_t offset = 0;
+        for (BlockCounts& counts : blocks) {
+            ptrdiff_t count = counts.count[bucket];
+            counts.count[bucket] = offset;
+            offset += count;
+        }
+
+        PlacedVector<int>& next = candidates[target];
+        if (next.size() < static_cast<size_t>(offset)) {
+            next.resize(offset);
+        }
+        peak_candidates[target] = std::max(peak_candidates[target], static_cast<size_t>(offset));
+        int* out = next.data();
+
+        forEachBlock(length, [&](ptrdiff_t block, ptrdiff_t begin, ptrdiff_t end) {
+            ptrdiff_t position = blocks[block].count[bucket];
+            // The bucket holding k is usually the small middle one, so this branch predicts well
+            for (ptrdiff_t i = begin; i < end; i++) {
+                int element = active[i];
+                if (classify(element, low_pivot, high_pivot) == bucket) {
+                    out[position++] = element;
+                }
+            }
+        });
+        comparisons += 2 * static_cast<uint64_t>(length);
+
+        narrowed = next.data();
+        active = narrowed;
+        length = offset;
+        target ^= 1;
+    }
+
+    if (!found) {
+        // The input itself was small: work on a copy, it is only read
+        if (narrowed == nullptr) {
+            PlacedVector<int>& copy = candidates[target];
+            if (copy.size() < static_cast<size_t>(length)) {
+                copy.resize(length);
+            }
+            std::copy(data.begin(), data.end(), copy.begin());
+            peak_candidates[target] = static_cast<size_t>(length);
+            narrowed = copy.data();
+        }
+        AlgorithmResult sequential_result = sequential.quickSelectWithMetrics(Span<int>(narrowed, length), k);
+        comparisons += sequential_result.comparisons;
+        result = sequential_result.value;
+    }
+
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+    // Both candidate buffers at their largest plus the sample
+    size_t additional_memory = sizeof(int) * (peak_candidates[0] + peak_candidates[1] + SAMPLE_SIZE);
+
+    return AlgorithmResult::forSelection("ParallelQuickSelect", result, execution_time, comparisons, additional_memory);
+}
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h): one pool and selector
+// per thread count, compared against the sequential block QuickSelect
+inline const bool parallel_quick_select_registered = AlgorithmRegistry::add({"parallel_quick_select", "Parallel QuickSelect", SELECTS | PARALLEL,
+    [](size_t threads) -> AlgorithmRunner {
+        auto pool = std::make_shared<ThreadPool>(threads);
+        auto selector = std::make_shared<ParallelQuickSelect>(*pool);
+        return [pool, selector](const AlgorithmRequest& request) { return selector->selectWithMetrics(request.data, request.k); };
+    }, -1.0, 0.0, "quick_select_block"});
+
+#endif // PARALLEL_QUICK_SELECT_H
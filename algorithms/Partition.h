@@ -0,0 +1,119 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "MetricsPolicy.h"
+#include "../Span.h"
+
+/**
+ * Partition strategy shared by QuickSort and QuickSelect:
+ *   - CLASSIC: the algorithm's own scheme (Hoare for QuickSort, Lomuto for QuickSelect)
+ *   - BLOCK:   BlockPartition, the branchless block-based scheme below
+ */
+enum class PartitionScheme {
+    CLASSIC,
+    BLOCK
+};
+
+/**
+ * @class BlockPartition
+ * @brief BlockQuicksort-style partitioning (Edelkamp & Weiss) without data-dependent branches.
+ *
+ * The left and right ends are scanned in blocks of BLOCK_SIZE elements. The scan only
+ * records the offsets of misplaced elements, advancing a counter by the result of the
+ * comparison instead of branching on it; the recorded elements are then swapped
+ * pairwise. Elements equal to the pivot count as misplaced on both sides, which keeps
+ * the partition balanced on duplicate-heavy inputs. The remainder that no longer
+ * fills two blocks is finished with a scalar Hoare pass.
+ */
+class BlockPartition {
+public:
+    static constexpr int BLOCK_SIZE = 64;
+
+    /**
+     * Partitions data[low..high] around the pivot stored at data[high].
+     *
+     * @param data The array to be partitioned
+     * @param low The starting index of the partition
+     * @param high The ending index of the partition, holding the pivot
+     * @param[out] metrics Metrics policy (see MetricsPolicy.h) collecting comparisons and swaps
+     * @param compare Strict weak ordering of the elements
+     * @return The final position p of the pivot: data[low..p-1] <= pivot <= data[p+1..high]
+     */
+    template <typename T, typename Metrics, typename Compare = std::less<T>>
+    static ptrdiff_t partition(Span<T> data, ptrdiff_t low, ptrdiff_t high, Metrics& metrics, Compare compare = Compare()) {
+        T pivot = data[high];
+        T* base = data.data();
+        ptrdiff_t begin = low;
+        ptrdiff_t end = high;  // exclusive, the pivot sits at high
+
+        unsigned char offsets_left[BLOCK_SIZE];
+        unsigned char offsets_right[BLOCK_SIZE];
+        int count_left = 0, count_right = 0;
+        int start_left = 0, start_right = 0;
+
+        while (end - begin > 2 * BLOCK_SIZE) {
+            if (count_left == 0) {
+                start_left = 0;
+                for (int i = 0; i < BLOCK_SIZE; ++i) {
+                    offsets_left[count_left] = static_cast<unsigned char>(i);
+                    count_left += !compare(base[begin + i], pivot);
+                }
+                metrics.comparison(BLOCK_SIZE);
+            }
+            if (count_right == 0) {
+                start_right = 0;
+                for (int i = 0; i < BLOCK_SIZE; ++i) {
+                    offsets_right[count_right] = static_cast<unsigned char>(i);
+                    count_right += !compare(pivot, base[end - 1 - i]);
+                }
+                metrics.comparison(BLOCK_SIZE);
+            }
+
+            int swaps = std::min(count_left, count_right);
+            for (int j = 0; j < swaps; ++j) {
+                std::swap(base[begin + offsets_left[start_left + j]],
+                          base[end - 1 - offsets_right[start_right + j]]);
+            }
+            metrics.swap(swaps);
+
+            count_left -= swaps;
+            count_right -= swaps;
+            start_left += swaps;
+            start_right += swaps;
+            if (count_left == 0) begin += BLOCK_SIZE;
+            if (count_right == 0) end -= BLOCK_SIZE;
+        }
+
+        // Everything before begin is <= pivot and everything from end on is >= pivot;
+        // a half-processed block is simply partitioned again by the scalar pass
+        ptrdiff_t i = begin, j = end - 1;
+        while (true) {
+            while (i <= j && compare(base[i], pivot)) {
+                i++;
+                metrics.comparison();
+            }
+            while (i <= j && compare(pivot, base[j])) {
+                j--;
+                metrics.comparison();
+            }
+            if (i >= j) {
+                break;
+            }
+            std::swap(base[i], base[j]);
+            metrics.swap();
+            i++;
+            j--;
+        }
+
+        std::swap(base[i], base[high]);
+        metrics.swap();
+        return i;
+    }
+};
+
+#endif // PARTITION_H
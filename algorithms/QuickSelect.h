@@ -4,16 +4,35 @@
 #include <vector>
 #include <cstdint>  // for uint64_t
 #include <chrono>  // for timing
-#include <cstdlib>  // for rand()
 #include <algorithm> // for std::swap
+#include <cmath>  // for log2
+#include <functional>  // for std::less
+#include <random>  // for std::mt19937_64
+#include <cstddef>  // for ptrdiff_t
 #include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "Partition.h"
+#include "MetricsPolicy.h"
 
 /**
- * @class QuickSelect
+ * @class BasicQuickSelect
  * @brief Implements the QuickSelect algorithm to find the k-th smallest element in an unsorted array.
+ *
+ * @tparam Metrics Instrumentation policy (see MetricsPolicy.h); NoMetrics compiles the counters away.
+ * @tparam T Element type
+ * @tparam Compare Strict weak ordering of the elements
  */
-class QuickSelect {
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicQuickSelect {
 private:
+    // Partition strategy
+    PartitionScheme scheme;
+    // Element ordering
+    Compare compare;
+    // Pivot positions; reseeded per engine, advanced by the const select calls
+    mutable std::mt19937_64 gen{std::random_device{}()};
+
     /**
      * Partitions the array around a pivot element such that elements smaller than the pivot
      * are on the left and elements greater than the pivot are on the right.
@@ -21,25 +40,27 @@ private:
      * @param data The array to be partitioned
      * @param left The starting index of the partition
      * @param right The ending index of the partition
-     * @param[out] comparison_count Counter for element comparisons
+     * @param[out] metrics Instrumentation policy receiving comparisons and swaps
      * @return The final position of the pivot element
      */
-    int partition(std::vector<int>& data, int left, int right, uint64_t& comparison_count) const {
+    ptrdiff_t partition(Span<T> data, ptrdiff_t left, ptrdiff_t right, Metrics& metrics) const {
         // Choose the rightmost element as pivot
-        int pivot_value = data[right];
-        int smaller_element_index = left - 1;
+        T pivot_value = data[right];
+        ptrdiff_t smaller_element_index = left - 1;
 
-        for (int current_index = left; current_index < right; ++current_index) {
+        for (ptrdiff_t current_index = left; current_index < right; ++current_index) {
             // If current element is smaller than or equal to pivot
-            comparison_count++;
-            if (data[current_index] <= pivot_value) {
+            metrics.comparison();
+            if (!compare(pivot_value, data[current_index])) {
                 ++smaller_element_index;
                 std::swap(data[smaller_element_index], data[current_index]);
+                metrics.swap();
             }
         }
         
         // Place the pivot element in its correct position
         std::swap(data[smaller_element_index + 1], data[right]);
+        metrics.swap();
         return smaller_element_index + 1;
     }
 
@@ -49,17 +70,21 @@ private:
      * @param data The array to be partitioned
      * @param left The starting index of the partition
      * @param right The ending index of the partition
-     * @param[out] comparison_count Counter for element comparisons
+     * @param[out] metrics Instrumentation policy receiving comparisons and swaps
      * @return The final position of the randomly selected pivot
      */
-    int randomPartition(std::vector<int>& data, int left, int right, uint64_t& comparison_count) const {
+    ptrdiff_t randomPartition(Span<T> data, ptrdiff_t left, ptrdiff_t right, Metrics& metrics) const {
         // Generate a random number between left and right
-        int random_index = left + rand() % (right - left + 1);
+        ptrdiff_t random_index = std::uniform_int_distribution<ptrdiff_t>(left, right)(gen);
         
         // Swap the element at random index with the rightmost element
         std::swap(data[random_index], data[right]);
+        metrics.swap();
         
-        return partition(data, left, right, comparison_count);
+        if (scheme == PartitionScheme::BLOCK) {
+            return BlockPartition::partition(data, left, right, metrics, compare);
+        }
+        return partition(data, left, right, metrics);
     }
 
     /**
@@ -69,57 +94,97 @@ private:
      * @param left The starting index of the current partition
      * @param right The ending index of the current partition
      * @param k The position of the element to find (0-based index)
-     * @param[out] comparison_count Counter for element comparisons
-     * @return The k-th smallest element
+     * @param[out] metrics Instrumentation policy receiving comparisons and swaps
+     * @return The k-th smallest element, also left at data[left + k]
      */
-    int quickSelect(std::vector<int>& data, int left, int right, int k, uint64_t& comparison_count) const {
+    const T& quickSelect(Span<T> data, ptrdiff_t left, ptrdiff_t right, ptrdiff_t k, Metrics& metrics) const {
         if (left == right) {
             return data[left];
         }
 
-        int pivot_index = randomPartition(data, left, right, comparison_count);
+        ptrdiff_t pivot_index = randomPartition(data, left, right, metrics);
         
-        int elements_before_pivot = pivot_index - left + 1;
-        comparison_count++;
+        ptrdiff_t elements_before_pivot = pivot_index - left + 1;
+        metrics.comparison();
 
         if (k == elements_before_pivot - 1) {
             return data[pivot_index];
         } 
         
         if (k < elements_before_pivot - 1) {
-            return quickSelect(data, left, pivot_index - 1, k, comparison_count);
+            return quickSelect(data, left, pivot_index - 1, k, metrics);
         } 
         else {
-            return quickSelect(data, pivot_index + 1, right, k - elements_before_pivot, comparison_count);
+            return quickSelect(data, pivot_index + 1, right, k - elements_before_pivot, metrics);
         }
     }
 
 public:
+    /**
+     * @param scheme Partition strategy used at every step
+     * @param compare Element ordering
+     */
+    explicit BasicQuickSelect(PartitionScheme scheme = PartitionScheme::CLASSIC, Compare compare = Compare())
+        : scheme(scheme), compare(compare) {}
+
     /**
      * @brief Finds the k-th smallest element in the array with performance metrics.
      * 
-     * @param data The input array (will be modified during execution)
+     * @param data The input array, reordered in place; the k-th smallest element ends up at data[k]
      * @param k The position of the element to find (0-based index)
-     * @return AlgorithmResult containing the result and performance metrics
+     * @return AlgorithmResult containing the result (int elements only) and performance metrics
      */
-    AlgorithmResult quickSelectWithMetrics(const std::vector<int>& data, int k) const {
-        auto start_time = std::chrono::high_resolution_clock::now();
-        uint64_t comparisons = 0;
-        
-        // Make a copy to avoid modifying the original array
-        std::vector<int> data_copy = data;
-        
-        // Calculate initial memory usage (just the copy of the vector)
-        size_t memory_used = sizeof(int) * data_copy.capacity();
+    AlgorithmResult quickSelectWithMetrics(Span<T> data, size_t k) const {
+        auto start_time = std::chrono::steady_clock::now();
+        Metrics metrics;
         
         // Find the k-th smallest element
-        int result = quickSelect(data_copy, 0, data_copy.size() - 1, k, comparisons);
+        int result = selectedValue(quickSelect(data, 0, static_cast<ptrdiff_t>(data.size()) - 1, static_cast<ptrdiff_t>(k), metrics));
         
-        auto end_time = std::chrono::high_resolution_clock::now();
+        // The recursion keeps one frame of bounds and rank per level, O(log n) expected
+        size_t memory_used = 4 * sizeof(int) * (1 + static_cast<size_t>(std::log2(std::max<size_t>(1, data.size()))));
+        
+        auto end_time = std::chrono::steady_clock::now();
         double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         
-        return AlgorithmResult::forSelection("QuickSelect", result, execution_time, comparisons, memory_used);
+        AlgorithmResult algorithm_result = AlgorithmResult::forSelection("QuickSelect", result, execution_time, metrics.comparisons(), memory_used);
+        algorithm_result.swaps = metrics.swaps();
+        return algorithm_result;
     }
 };
 
+using QuickSelect = BasicQuickSelect<CountComparisons>;
+
+// Engines registered with the benchmark (see AlgorithmRegistry.h)
+inline bool registerQuickSelectEngines() {
+    auto select = [](auto& selector, const AlgorithmRequest& request) { return selector.quickSelectWithMetrics(request.data, request.k); };
+    AlgorithmRegistry::add({"quick_select", "QuickSelect", SELECTS, engineFactory<BasicQuickSelect<CountComparisonsAndSwaps>>(select)});
+    AlgorithmRegistry::add({"quick_select_uncounted", "QuickSelect Uncounted", SELECTS, engineFactory<BasicQuickSelect<NoMetrics>>(select)});
+    AlgorithmRegistry::add({"quick_select_block", "QuickSelect Block", SELECTS, engineFactory<QuickSelect>(select, PartitionScheme::BLOCK)});
+
+    // Baseline for MultiSelect: one independent block QuickSelect per rank, each on a
+    // fresh copy of the input. Only the calls' own times are summed, so the copies
+    // are not part of the time
+    AlgorithmRegistry::add({"repeated_quick_select_block", "Repeated QuickSelect Block", SELECTS_MANY, [](size_t) -> AlgorithmRunner {
+        auto selector = std::make_shared<QuickSelect>(PartitionScheme::BLOCK);
+        auto pristine = std::make_shared<std::vector<int>>();
+        return [selector, pristine](const AlgorithmRequest& request) {
+            pristine->assign(request.data.begin(), request.data.end());
+            AlgorithmResult repeated;
+            for (size_t k : *request.ranks) {
+                std::copy(pristine->begin(), pristine->end(), request.data.begin());
+                AlgorithmResult single_result = selector->quickSelectWithMetrics(request.data, k);
+                repeated.execution_time += single_result.execution_time;
+                repeated.comparisons += single_result.comparisons;
+                repeated.memory_usage = std::max(repeated.memory_usage, single_result.memory_usage);
+                repeated.values.push_back(single_result.value);
+            }
+            return repeated;
+        };
+    }});
+    return true;
+}
+
+inline const bool quick_select_engines_registered = registerQuickSelectEngines();
+
 #endif // QUICK_SELECT_H
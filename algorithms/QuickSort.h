@@ -8,48 +8,78 @@
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
 #include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "Partition.h"
+#include "SimdSort.h"
+#include "MetricsPolicy.h"
 
-class QuickSort {
+/**
+ * Quick sort templated on a metrics policy (see MetricsPolicy.h), the element type
+ * and a strict weak ordering; QuickSort is the comparison-counting int instantiation.
+ */
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicQuickSort {
 private:
-    // Member variable to count comparisons
-    uint64_t comparisons;
+    // The SIMD sorting network sorts ints in ascending order only
+    static constexpr bool SIMD_CAPABLE = std::is_same<T, int>::value && std::is_same<Compare, std::less<int>>::value;
+
+    // Metrics policy collecting comparisons and swaps
+    Metrics metrics;
     // Random number generator
     std::random_device rd;
-    std::mt19937 gen;
+    std::mt19937_64 gen;
+    // Partition strategy
+    PartitionScheme scheme;
+    // Whether ranges of up to SimdSort::MAX_SMALL_SORT elements go to the SIMD sorting network
+    bool simd_base_case;
+    // Element ordering
+    Compare compare;
     
     // Private helper methods
-    int partition(std::vector<int>& arr, int low, int high);
-    int randomPartition(std::vector<int>& arr, int low, int high);
-    void quickSort(std::vector<int>& arr, int low, int high);
+    ptrdiff_t partition(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
+    ptrdiff_t randomPartition(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
+    void quickSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high);
     
 public:
-    // Constructor
-    QuickSort() : comparisons(0), gen(rd()) {}
+    // Constructor; simd_base_case requires int elements and the default ordering
+    explicit BasicQuickSort(PartitionScheme scheme = PartitionScheme::CLASSIC, bool simd_base_case = false, Compare compare = Compare())
+        : gen(rd()), scheme(scheme), simd_base_case(simd_base_case), compare(compare) {
+        if (simd_base_case && !SIMD_CAPABLE) {
+            throw std::invalid_argument("The SIMD base case only sorts int in ascending order");
+        }
+    }
     
-    // Public interface
-    AlgorithmResult sortWithMetrics(std::vector<int> arr);
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<T> arr);
 };
 
+using QuickSort = BasicQuickSort<CountComparisons>;
+
 // Implementation of the methods
-inline int QuickSort::partition(std::vector<int>& arr, int low, int high) {
-    int pivot = arr[low];
-    int i = low, j = high;
+template <typename Metrics, typename T, typename Compare>
+inline ptrdiff_t BasicQuickSort<Metrics, T, Compare>::partition(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
+    T pivot = arr[low];
+    ptrdiff_t i = low, j = high;
 
     while (true) {
         // Find leftmost element >= pivot
-        while (i <= high && arr[i] < pivot) {
+        while (i <= high && compare(arr[i], pivot)) {
             i++;
-            comparisons++;
+            metrics.comparison();
         }
-        comparisons++; // for the last comparison that failed
+        metrics.comparison(); // for the last comparison that failed
 
         // Find rightmost element <= pivot
-        while (j >= low && arr[j] > pivot) {
+        while (j >= low && compare(pivot, arr[j])) {
             j--;
-            comparisons++;
+            metrics.comparison();
         }
-        comparisons++; // for the last comparison that failed
+        metrics.comparison(); // for the last comparison that failed
 
         // If pointers crossed
         if (i >= j) {
@@ -58,14 +88,17 @@ inline int QuickSort::partition(std::vector<int>& arr, int low, int high) {
 
         // Swap elements and move pointers
         std::swap(arr[i], arr[j]);
+        metrics.swap();
         i++;
         j--;
     }
 }
 
-inline int QuickSort::randomPartition(std::vector<int>& arr, int low, int high) {
+template <typename Metrics, typename T, typename Compare>
+inline ptrdiff_t BasicQuickSort<Metrics, T, Compare>::randomPartition(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
     // Validate input
-    if (low < 0 || high < 0 || low >= arr.size() || high >= arr.size() || low > high) {
+    ptrdiff_t size = static_cast<ptrdiff_t>(arr.size());
+    if (low < 0 || high < 0 || low >= size || high >= size || low > high) {
         throw std::invalid_argument("Invalid partition indices");
     }
     
@@ -74,25 +107,51 @@ inline int QuickSort::randomPartition(std::vector<int>& arr, int low, int high)
     }
     
     // Generate random index between low and high (inclusive)
-    std::uniform_int_distribution<> distrib(low, high);
-    int random = distrib(gen);
+    std::uniform_int_distribution<ptrdiff_t> distrib(low, high);
+    ptrdiff_t random = distrib(gen);
+    
+    if (scheme == PartitionScheme::BLOCK) {
+        // Block partitioning expects the pivot at the end of the range
+        std::swap(arr[random], arr[high]);
+        metrics.swap();
+        return BlockPartition::partition(arr, low, high, metrics, compare);
+    }
     
     // Swap with first element
     std::swap(arr[random], arr[low]);
+    metrics.swap();
     
     return partition(arr, low, high);
 }
 
-inline void QuickSort::quickSort(std::vector<int>& arr, int low, int high) {
-    if (low < 0 || high < 0 || low >= arr.size() || high >= arr.size()) {
+template <typename Metrics, typename T, typename Compare>
+inline void BasicQuickSort<Metrics, T, Compare>::quickSort(Span<T> arr, ptrdiff_t low, ptrdiff_t high) {
+    ptrdiff_t size = static_cast<ptrdiff_t>(arr.size());
+    if (low < 0 || high < 0 || low >= size || high >= size) {
         throw std::invalid_argument("Invalid sort indices");
     }
     
+    if constexpr (SIMD_CAPABLE) {
+        if (simd_base_case && high - low + 1 <= SimdSort::MAX_SMALL_SORT) {
+            uint64_t scalar_comparisons = 0, vector_comparisons = 0;
+            SimdSort::sortSmall(arr.data() + low, static_cast<int>(high - low + 1), scalar_comparisons, vector_comparisons);
+            metrics.comparison(scalar_comparisons);
+            metrics.vectorComparison(vector_comparisons);
+            return;
+        }
+    }
+    
     if (low < high) {
         try {
-            int pi = randomPartition(arr, low, high);
-            quickSort(arr, low, pi);
-            quickSort(arr, pi + 1, high);
+            ptrdiff_t pi = randomPartition(arr, low, high);
+            if (scheme == PartitionScheme::BLOCK) {
+                // The pivot is already in its final position
+                if (pi > low) quickSort(arr, low, pi - 1);
+                if (pi < high) quickSort(arr, pi + 1, high);
+            } else {
+                quickSort(arr, low, pi);
+                quickSort(arr, pi + 1, high);
+            }
         } catch (const std::exception& e) {
             std::cerr << "Sorting error: " << e.what() << std::endl;
             throw;
@@ -100,21 +159,37 @@ inline void QuickSort::quickSort(std::vector<int>& arr, int low, int high) {
     }
 }
 
-inline AlgorithmResult QuickSort::sortWithMetrics(std::vector<int> arr) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-    comparisons = 0;
+template <typename Metrics, typename T, typename Compare>
+inline AlgorithmResult BasicQuickSort<Metrics, T, Compare>::sortWithMetrics(Span<T> arr) {
+    auto start_time = std::chrono::steady_clock::now();
+    metrics.reset();
     
     if (!arr.empty()) {
-        quickSort(arr, 0, arr.size() - 1);
+        quickSort(arr, 0, static_cast<ptrdiff_t>(arr.size()) - 1);
     }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
+    auto end_time = std::chrono::steady_clock::now();
     double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
-    // QuickSort uses O(log n) stack space in the best/average case
-    size_t stack_usage = sizeof(int) * (1 + log2(arr.size()));
-    
-    return AlgorithmResult::forSorting("QuickSort", std::move(arr), execution_time, comparisons, stack_usage);
+    // The recursion follows both sides, so its depth has no bound below n: no estimate is
+    // given and the benchmark reports the measured stack high-water mark instead
+    AlgorithmResult result = AlgorithmResult::forSorting("QuickSort", sortedView(arr), execution_time, metrics.comparisons(), 0);
+    result.vector_comparisons = metrics.vectorComparisons();
+    result.swaps = metrics.swaps();
+    return result;
 }
 
+// Engines registered with the benchmark (see AlgorithmRegistry.h)
+inline bool registerQuickSortEngines() {
+    auto sort = [](auto& sorter, const AlgorithmRequest& request) { return sorter.sortWithMetrics(request.data); };
+    AlgorithmRegistry::add({"quick_sort", "Quick Sort", SORTS, engineFactory<BasicQuickSort<CountComparisonsAndSwaps>>(sort)});
+    AlgorithmRegistry::add({"quick_sort_block", "Quick Sort Block", SORTS, engineFactory<QuickSort>(sort, PartitionScheme::BLOCK)});
+    AlgorithmRegistry::add({"quick_sort_simd", "Quick Sort SIMD", SORTS, engineFactory<QuickSort>(sort, PartitionScheme::CLASSIC, true)});
+    // Counters compiled out; the time difference to quick_sort is the cost of the instrumentation
+    AlgorithmRegistry::add({"quick_sort_uncounted", "Quick Sort Uncounted", SORTS, engineFactory<BasicQuickSort<NoMetrics>>(sort)});
+    return true;
+}
+
+inline const bool quick_sort_engines_registered = registerQuickSortEngines();
+
 #endif // QUICKSORT_H
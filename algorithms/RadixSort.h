@@ -0,0 +1,117 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "../PageAllocator.h"
+
+/**
+ * @class RadixSort
+ * @brief LSD radix sort for 32-bit signed integers.
+ *
+ * Keys are processed as four 8-bit digits, so each pass works with a 256-entry
+ * histogram that stays resident in L1. A single pre-pass over the input builds
+ * the histograms of all digits at once; passes whose digit is the same for every
+ * element are skipped. Signed values are handled by flipping the sign bit, which
+ * maps the int range onto unsigned order. Data ping-pongs between the input and
+ * a scratch buffer kept across sortWithMetrics calls.
+ */
+class RadixSort {
+private:
+    static constexpr int DIGIT_BITS = 8;
+    static constexpr int RADIX = 1 << DIGIT_BITS;
+    static constexpr int PASSES = 32 / DIGIT_BITS;
+
+    // Scratch buffer, kept across sortWithMetrics calls
+    PlacedVector<int> buffer;
+
+    // Private helper methods
+    static uint32_t key(int value);
+    void sort(Span<int> arr);
+
+public:
+    // Public interface: sorts arr in place
+    AlgorithmResult sortWithMetrics(Span<int> arr);
+};
+
+// Implementation of the methods
+inline uint32_t RadixSort::key(int value) {
+    return static_cast<uint32_t>(value) ^ 0x80000000u;
+}
+
+inline void RadixSort::sort(Span<int> arr) {
+    size_t n = arr.size();
+    size_t histograms[PASSES][RADIX] = {};
+
+    // One pre-pass builds the histograms of every digit
+    for (size_t i = 0; i < n; i++) {
+        uint32_t k = key(arr[i]);
+        for (int pass = 0; pass < PASSES; pass++) {
+            histograms[pass][(k >> (pass * DIGIT_BITS)) & (RADIX - 1)]++;
+        }
+    }
+
+    int* src = arr.data();
+    int* dst = buffer.data();
+
+    for (int pass = 0; pass < PASSES; pass++) {
+        size_t* counts = histograms[pass];
+        int shift = pass * DIGIT_BITS;
+
+        // A digit shared by every element would only copy the data around
+        if (counts[(key(src[0]) >> shift) & (RADIX - 1)] == n) {
+            continue;
+        }
+
+        // Turn the counts into starting offsets
+        size_t offset = 0;
+        for (int digit = 0; digit < RADIX; digit++) {
+            size_t count = counts[digit];
+            counts[digit] = offset;
+            offset += count;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            int value = src[i];
+            dst[counts[(key(value) >> shift) & (RADIX - 1)]++] = value;
+        }
+        std::swap(src, dst);
+    }
+
+    // After an odd number of executed passes the sorted data lives in the scratch buffer
+    if (src != arr.data()) {
+        std::copy(buffer.begin(), buffer.begin() + n, arr.begin());
+    }
+}
+
+inline AlgorithmResult RadixSort::sortWithMetrics(Span<int> arr) {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    if (!arr.empty()) {
+        // Grow the scratch buffer only when a larger input shows up
+        if (buffer.size() < arr.size()) {
+            buffer.resize(arr.size());
+        }
+        sort(arr);
+    }
+    
+    auto end_time = std::chrono::steady_clock::now();
+    double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    
+    // Scratch buffer plus the digit histograms; radix sort performs no comparisons
+    size_t additional_memory = sizeof(int) * arr.size() + sizeof(size_t) * PASSES * RADIX;
+    
+    return AlgorithmResult::forSorting("RadixSort", arr, execution_time, 0, additional_memory);
+}
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h)
+inline const bool radix_sort_registered = AlgorithmRegistry::add({"radix_sort", "Radix Sort", SORTS,
+    engineFactory<RadixSort>([](RadixSort& sorter, const AlgorithmRequest& request) { return sorter.sortWithMetrics(request.data); })});
+
+#endif // RADIXSORT_H
@@ -0,0 +1,112 @@
+#ifndef RECORD_SORT_H
+#define RECORD_SORT_H
+
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include "../AlgorithmResult.h"
+#include "../Span.h"
+#include "Argsort.h"
+#include "MetricsPolicy.h"
+
+/**
+ * (key, payload) record stored as one struct: sorting moves 4 + PayloadBytes
+ * bytes (plus padding) per element
+ */
+template <size_t PayloadBytes>
+struct Record {
+    int key;
+    std::array<unsigned char, PayloadBytes> payload;
+};
+
+template <size_t PayloadBytes>
+using RecordPayload = std::array<unsigned char, PayloadBytes>;
+
+// Orders records by key only
+struct ByRecordKey {
+    template <typename R>
+    bool operator()(const R& a, const R& b) const {
+        return a.key < b.key;
+    }
+};
+
+/**
+ * How the records are laid out in memory:
+ *   - AOS: an array of Record structs, sorted directly; every move copies the payload
+ *   - SOA: a key array and a parallel payload array; the keys are argsorted and both
+ *          columns are then gathered once through the permutation
+ */
+enum class RecordLayout {
+    AOS,
+    SOA
+};
+
+/**
+ * @class BasicRecordSort
+ * @brief Sorts (key, payload) records in either layout with the same sorter algorithm.
+ *
+ * The AoS sort pays for the payload on every element move, the SoA sort moves
+ * indices during the sort and each payload exactly once afterwards, at the price
+ * of indirect key reads and an O(n) permutation. Which one wins depends on the
+ * payload size and on how many moves the sorter makes, which is what the record
+ * sorting benchmark measures.
+ *
+ * @tparam Sorter Sorter template taking <Metrics, element type, comparator>
+ * @tparam Metrics Instrumentation policy (see MetricsPolicy.h)
+ * @tparam PayloadBytes Payload size of every record
+ */
+template <template <typename, typename, typename> class Sorter, typename Metrics, size_t PayloadBytes>
+class BasicRecordSort {
+private:
+    using Payload = RecordPayload<PayloadBytes>;
+
+    Sorter<Metrics, Record<PayloadBytes>, ByRecordKey> record_sorter;
+    BasicArgsort<Sorter, Metrics> argsort;
+    // Scratch kept across calls: the permutation and the gathered columns
+    std::vector<size_t> permutation;
+    std::vector<int> gathered_keys;
+    std::vector<Payload> gathered_payloads;
+
+public:
+    /**
+     * @param strategy The sorter's mode (MergeSortMode or PartitionScheme), used by both layouts
+     */
+    template <typename Strategy>
+    explicit BasicRecordSort(Strategy strategy) : record_sorter(strategy), argsort(strategy) {}
+
+    // AoS: sorts records in place by key
+    AlgorithmResult sortRecordsWithMetrics(Span<Record<PayloadBytes>> records) {
+        return record_sorter.sortWithMetrics(records);
+    }
+
+    /**
+     * @brief SoA: sorts keys in place and applies the same permutation to payloads.
+     *
+     * @param keys The key column
+     * @param payloads The payload column, payloads[i] belonging to keys[i]
+     */
+    AlgorithmResult sortColumnsWithMetrics(Span<int> keys, Span<Payload> payloads) {
+        auto start_time = std::chrono::steady_clock::now();
+
+        AlgorithmResult result = argsort.argsortWithMetrics(keys, permutation);
+
+        size_t n = keys.size();
+        gathered_keys.resize(n);
+        gathered_payloads.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            gathered_keys[i] = keys[permutation[i]];
+            gathered_payloads[i] = payloads[permutation[i]];
+        }
+        std::copy(gathered_keys.begin(), gathered_keys.end(), keys.begin());
+        std::copy(gathered_payloads.begin(), gathered_payloads.end(), payloads.begin());
+
+        auto end_time = std::chrono::steady_clock::now();
+        result.algorithm_name = "RecordSortSoA";
+        result.execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        result.memory_usage += (sizeof(int) + sizeof(Payload)) * n;
+        return result;
+    }
+};
+
+#endif // RECORD_SORT_H
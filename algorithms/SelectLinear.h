@@ -5,96 +5,131 @@
 #include <algorithm>
 #include <chrono>
 #include <stdexcept>
+#include <functional>
 #include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+#include "MetricsPolicy.h"
 
-class SelectLinear {
+/**
+ * @class BasicSelectLinear
+ * @brief Median-of-medians selection on copied partitions.
+ *
+ * @tparam Metrics Instrumentation policy (see MetricsPolicy.h); NoMetrics compiles the counters away.
+ * @tparam T Element type
+ * @tparam Compare Strict weak ordering of the elements
+ */
+template <typename Metrics, typename T = int, typename Compare = std::less<T>>
+class BasicSelectLinear {
 private:
     // Member variables to track metrics
-    static inline size_t comparison_count = 0;
-    static inline size_t additional_memory = 0;
+    Metrics metrics;
+    size_t additional_memory = 0;
+    // Element ordering
+    Compare compare;
+    // Answer of the last selectLinearWithMetrics call
+    T selected_element = T();
 
     // Find median of small array (size <= 5)
-    static int median(std::vector<int>& arr) {
-        std::sort(arr.begin(), arr.end(), [](int a, int b) {
-            SelectLinear::comparison_count++;
-            return a < b;
+    T median(std::vector<T>& arr) {
+        std::sort(arr.begin(), arr.end(), [this](const T& a, const T& b) {
+            metrics.comparison();
+            return compare(a, b);
         });
         return arr[arr.size() / 2];
     }
 
     // Recursive function to find k-th smallest element
-    static int select_linear(std::vector<int> arr, int k) {
+    T select_linear(std::vector<T> arr, size_t k) {
         if (arr.size() <= 5) {
-            std::sort(arr.begin(), arr.end(), [](int a, int b) {
-                SelectLinear::comparison_count++;
-                return a < b;
+            std::sort(arr.begin(), arr.end(), [this](const T& a, const T& b) {
+                metrics.comparison();
+                return compare(a, b);
             });
             return arr[k];
         }
 
-        std::vector<int> medians;
+        std::vector<T> medians;
         for (size_t i = 0; i < arr.size(); i += 5) {
-            std::vector<int> group;
+            std::vector<T> group;
             for (size_t j = i; j < i + 5 && j < arr.size(); ++j)
                 group.push_back(arr[j]);
-            medians.push_back(SelectLinear::median(group));
+            medians.push_back(median(group));
         }
 
-        SelectLinear::additional_memory += medians.capacity() * sizeof(int); 
-        int med_of_med = SelectLinear::select_linear(medians, medians.size() / 2);
-        std::vector<int> left, right, equal;
+        additional_memory += medians.capacity() * sizeof(T); 
+        T med_of_med = select_linear(medians, medians.size() / 2);
+        std::vector<T> left, right, equal;
 
-        for (int val : arr) {
-            SelectLinear::comparison_count++;
-            if (val < med_of_med) {
+        for (const T& val : arr) {
+            metrics.comparison();
+            if (compare(val, med_of_med)) {
                 left.push_back(val);
-            } else if (val > med_of_med) {
-                SelectLinear::comparison_count++;
+            } else if (compare(med_of_med, val)) {
+                metrics.comparison();
                 right.push_back(val);
             } else {
                 equal.push_back(val);
             }
         }
 
-        SelectLinear::additional_memory += (left.capacity() + right.capacity() + equal.capacity()) * sizeof(int);
+        additional_memory += (left.capacity() + right.capacity() + equal.capacity()) * sizeof(T);
 
         size_t left_size = left.size();
         size_t equal_size = equal.size();
         
-        if (k < static_cast<int>(left_size))
-            return SelectLinear::select_linear(left, k);
-        else if (k < static_cast<int>(left_size + equal_size))
+        if (k < left_size)
+            return select_linear(left, k);
+        else if (k < left_size + equal_size)
             return med_of_med;
         else
-            return SelectLinear::select_linear(right, k - left_size - equal_size);
+            return select_linear(right, k - left_size - equal_size);
     }
     
 public:
-    // Wrapper function for SelectLinear with metrics collection
-    static AlgorithmResult selectLinearWithMetrics(const std::vector<int>& data, int k) {
-        auto start_time = std::chrono::high_resolution_clock::now();
-        SelectLinear::comparison_count = 0;
-        SelectLinear::additional_memory = 0;
+    explicit BasicSelectLinear(Compare compare = Compare()) : compare(compare) {}
+
+    // Wrapper function for SelectLinear with metrics collection; the answer is in
+    // the result for int elements and in selected() for any element type
+    AlgorithmResult selectLinearWithMetrics(Span<const T> data, size_t k) {
+        auto start_time = std::chrono::steady_clock::now();
+        metrics.reset();
+        additional_memory = 0;
         
-        if (k < 0 || k >= static_cast<int>(data.size()))
+        if (k >= data.size())
             throw std::out_of_range("k is out of bounds");
         
-        std::vector<int> data_copy = data;
-        size_t initial_memory = sizeof(int) * data_copy.capacity();
-        int result = SelectLinear::select_linear(data_copy, k);
-        size_t peak_memory = sizeof(int) * data_copy.capacity() + SelectLinear::additional_memory;
+        // The algorithm partitions into new vectors; the first level copies the input
+        selected_element = select_linear(std::vector<T>(data.begin(), data.end()), k);
+        size_t peak_memory = sizeof(T) * data.size() + additional_memory;
         
-        auto end_time = std::chrono::high_resolution_clock::now();
+        auto end_time = std::chrono::steady_clock::now();
         double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         
         return AlgorithmResult::forSelection(
             "SelectLinear",
-            result,
+            selectedValue(selected_element),
             execution_time,
-            SelectLinear::comparison_count,
+            metrics.comparisons(),
             peak_memory
         );
     }
+
+    const T& selected() const {
+        return selected_element;
+    }
 };
 
+using SelectLinear = BasicSelectLinear<CountComparisons>;
+
+// Engines registered with the benchmark (see AlgorithmRegistry.h)
+inline bool registerSelectLinearEngines() {
+    auto select = [](auto& selector, const AlgorithmRequest& request) { return selector.selectLinearWithMetrics(request.data, request.k); };
+    AlgorithmRegistry::add({"select_linear", "Select Linear", SELECTS, engineFactory<SelectLinear>(select)});
+    AlgorithmRegistry::add({"select_linear_uncounted", "Select Linear Uncounted", SELECTS, engineFactory<BasicSelectLinear<NoMetrics>>(select)});
+    return true;
+}
+
+inline const bool select_linear_engines_registered = registerSelectLinearEngines();
+
 #endif // SELECT_LINEAR_H
\ No newline at end of file
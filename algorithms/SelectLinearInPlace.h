@@ -0,0 +1,176 @@
+#ifndef SELECT_LINEAR_IN_PLACE_H
+#define SELECT_LINEAR_IN_PLACE_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../Span.h"
+
+/**
+ * @class SelectLinearInPlace
+ * @brief Allocation-free median-of-medians selection.
+ *
+ * Works directly on the caller's range: each group of 5 is sorted with a fixed
+ * 9-comparator network and its median is swapped to the front of the range, the
+ * median of those medians is found recursively in that prefix, and the range is
+ * then 3-way partitioned around it. Only the medians prefix is recursed into;
+ * narrowing towards k is a loop, so the stack depth is O(log n) and no heap
+ * memory is used.
+ */
+class SelectLinearInPlace {
+private:
+    // Member variables to track metrics
+    uint64_t comparison_count;
+    size_t depth;
+    size_t max_depth;
+
+    void compareExchange(int* data, size_t i, size_t j) {
+        comparison_count++;
+        int a = data[i];
+        int b = data[j];
+        data[i] = std::min(a, b);
+        data[j] = std::max(a, b);
+    }
+
+    // Optimal 9-comparator sorting network for 5 elements
+    void sortGroupOfFive(int* group) {
+        compareExchange(group, 0, 1);
+        compareExchange(group, 3, 4);
+        compareExchange(group, 2, 4);
+        compareExchange(group, 2, 3);
+        compareExchange(group, 0, 3);
+        compareExchange(group, 0, 2);
+        compareExchange(group, 1, 4);
+        compareExchange(group, 1, 3);
+        compareExchange(group, 1, 2);
+    }
+
+    void insertionSort(int* data, size_t left, size_t right) {
+        for (size_t i = left + 1; i <= right; i++) {
+            int key = data[i];
+            size_t j = i;
+            while (j > left) {
+                comparison_count++;
+                if (data[j - 1] <= key) break;
+                data[j] = data[j - 1];
+                j--;
+            }
+            data[j] = key;
+        }
+    }
+
+    /**
+     * Rearranges data[left..right] so that data[k] holds the element that would be
+     * there if the range were sorted.
+     */
+    int select(int* data, size_t left, size_t right, size_t k) {
+        depth++;
+        max_depth = std::max(max_depth, depth);
+
+        while (true) {
+            size_t size = right - left + 1;
+            if (size <= 5) {
+                insertionSort(data, left, right);
+                depth--;
+                return data[k];
+            }
+
+            // Sort every full group of 5 and gather its median at the front
+            size_t group_count = size / 5;
+            for (size_t group = 0; group < group_count; group++) {
+                size_t start = left + 5 * group;
+                sortGroupOfFive(data + start);
+                std::swap(data[left + group], data[start + 2]);
+            }
+
+            // Median of medians, found in place within the medians prefix
+            size_t median_index = left + group_count / 2;
+            int pivot = select(data, left, left + group_count - 1, median_index);
+
+            // Dutch national flag partition: [left, lt) < pivot, [lt, gt] == pivot, (gt, right] > pivot
+            size_t lt = left, i = left, gt = right;
+            while (i <= gt) {
+                comparison_count++;
+                if (data[i] < pivot) {
+                    std::swap(data[lt++], data[i++]);
+                } else {
+                    comparison_count++;
+                    if (data[i] > pivot) {
+                        std::swap(data[i], data[gt]);
+                        gt--;
+                    } else {
+                        i++;
+                    }
+                }
+            }
+
+            if (k < lt) {
+                right = lt - 1;
+            } else if (k > gt) {
+                left = gt + 1;
+            } else {
+                depth--;
+                return pivot;
+            }
+        }
+    }
+
+public:
+    SelectLinearInPlace() : comparison_count(0), depth(0), max_depth(0) {}
+
+    /**
+     * Places the k-th smallest element of data[left..right] at data[k] and returns it.
+     * Used directly by engines that fall back to median-of-medians; metrics keep
+     * accumulating until resetMetrics is called.
+     */
+    int selectRange(int* data, size_t left, size_t right, size_t k) {
+        return select(data, left, right, k);
+    }
+
+    void resetMetrics() {
+        comparison_count = 0;
+        depth = 0;
+        max_depth = 0;
+    }
+
+    uint64_t comparisonCount() const {
+        return comparison_count;
+    }
+
+    // Peak stack space: each recursion level keeps its bounds, target and pivot alive
+    size_t peakMemory() const {
+        return max_depth * (3 * sizeof(size_t) + sizeof(int));
+    }
+
+    /**
+     * @brief Finds the k-th smallest element with performance metrics.
+     *
+     * @param data The input array, reordered in place
+     * @param k The position of the element to find (0-based index)
+     * @return AlgorithmResult whose memory usage is the peak stack space of the recursion
+     */
+    AlgorithmResult selectWithMetrics(Span<int> data, size_t k) {
+        auto start_time = std::chrono::steady_clock::now();
+        resetMetrics();
+        
+        if (k >= data.size())
+            throw std::out_of_range("k is out of bounds");
+        
+        int result = select(data.data(), 0, data.size() - 1, k);
+        
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        
+        return AlgorithmResult::forSelection("SelectLinearInPlace", result, execution_time, comparison_count, peakMemory());
+    }
+};
+
+// Engine registered with the benchmark (see AlgorithmRegistry.h)
+inline const bool select_linear_in_place_registered = AlgorithmRegistry::add({"select_linear_in_place", "Select Linear In-Place", SELECTS,
+    engineFactory<SelectLinearInPlace>([](SelectLinearInPlace& selector, const AlgorithmRequest& request) { return selector.selectWithMetrics(request.data, request.k); })});
+
+#endif // SELECT_LINEAR_IN_PLACE_H
@@ -0,0 +1,281 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @class SimdSort
+ * @brief AVX2 kernels for the leaves of QuickSort and MergeSort.
+ *
+ * - sortSmall: in-register bitonic sorting networks for up to 64 ints, held in
+ *   1, 2, 4 or 8 ymm registers (8/16/32/64 elements, padded with INT_MAX)
+ * - merge: vectorized bitonic merge of two sorted runs, 8 elements per step
+ *
+ * The AVX2 code is compiled with a function-level target attribute and chosen at
+ * runtime through CPUID, so the binary still runs on hosts without AVX2, where the
+ * scalar fallbacks are used. Vector compare operations (one min/max pair on a full
+ * register) are counted apart from scalar comparisons.
+ */
+class SimdSort {
+public:
+    static constexpr int MAX_SMALL_SORT = 64;
+
+    // CPUID check for AVX2, evaluated once
+    static bool available() {
+#ifdef SIMD_SORT_X86
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        return has_avx2;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Sorts data[0, n) with n <= MAX_SMALL_SORT.
+     *
+     * @param[out] comparisons Counter for scalar comparisons (fallback path)
+     * @param[out] vector_comparisons Counter for vector compare operations
+     */
+    static void sortSmall(int* data, int n, uint64_t& comparisons, uint64_t& vector_comparisons) {
+        if (n < 2) {
+            return;
+        }
+#ifdef SIMD_SORT_X86
+        if (available()) {
+            sortSmallAvx2(data, n, vector_comparisons);
+            return;
+        }
+#endif
+        insertionSort(data, n, comparisons);
+    }
+
+    /**
+     * Merges the sorted runs a[0, n1) and b[0, n2) into dst. dst may alias the
+     * memory right before b (in-place merge with a saved left run), since it
+     * never overtakes the read cursor of b.
+     */
+    static void merge(const int* a, ptrdiff_t n1, const int* b, ptrdiff_t n2, int* dst, uint64_t& comparisons, uint64_t& vector_comparisons) {
+#ifdef SIMD_SORT_X86
+        if (available() && n1 >= 8 && n2 >= 8) {
+            mergeAvx2(a, n1, b, n2, dst, comparisons, vector_comparisons);
+            return;
+        }
+#endif
+        scalarMerge(a, n1, b, n2, dst, comparisons);
+    }
+
+private:
+    static void insertionSort(int* data, int n, uint64_t& comparisons) {
+        for (int i = 1; i < n; i++) {
+            int key = data[i];
+            int j = i - 1;
+            while (j >= 0) {
+                comparisons++;
+                if (data[j] <= key) break;
+                data[j + 1] = data[j];
+                j--;
+            }
+            data[j + 1] = key;
+        }
+    }
+
+    static void scalarMerge(const int* a, ptrdiff_t n1, const int* b, ptrdiff_t n2, int* dst, uint64_t& comparisons) {
+        ptrdiff_t i = 0, j = 0, k = 0;
+        while (i < n1 && j < n2) {
+            comparisons++;
+            if (a[i] <= b[j]) {
+                dst[k++] = a[i++];
+            } else {
+                dst[k++] = b[j++];
+            }
+        }
+        while (i < n1)
+            dst[k++] = a[i++];
+        while (j < n2)
+            dst[k++] = b[j++];
+    }
+
+#ifdef SIMD_SORT_X86
+    /**
+     * One bitonic compare-exchange step inside a register: lane i is paired with
+     * lane i ^ distance; blocks of block_size lanes alternate direction, a
+     * block_size of 8 sorts the whole register ascending.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i compareExchange(__m256i v, int distance, int block_size, uint64_t& vector_comparisons) {
+        alignas(32) int permutation[8];
+        alignas(32) int take_max[8];
+        for (int i = 0; i < 8; i++) {
+            int partner = i ^ distance;
+            bool lower = i < partner;
+            bool descending = block_size < 8 && (i & block_size) != 0;
+            permutation[i] = partner;
+            take_max[i] = (lower == descending) ? -1 : 0;
+        }
+        __m256i swapped = _mm256_permutevar8x32_epi32(v, _mm256_load_si256(reinterpret_cast<const __m256i*>(permutation)));
+        __m256i low = _mm256_min_epi32(v, swapped);
+        __m256i high = _mm256_max_epi32(v, swapped);
+        vector_comparisons++;
+        return _mm256_blendv_epi8(low, high, _mm256_load_si256(reinterpret_cast<const __m256i*>(take_max)));
+    }
+
+    // Full bitonic sort of the 8 lanes of a register
+    __attribute__((target("avx2")))
+    static inline __m256i sort8(__m256i v, uint64_t& vector_comparisons) {
+        v = compareExchange(v, 1, 2, vector_comparisons);
+        v = compareExchange(v, 2, 4, vector_comparisons);
+        v = compareExchange(v, 1, 4, vector_comparisons);
+        v = compareExchange(v, 4, 8, vector_comparisons);
+        v = compareExchange(v, 2, 8, vector_comparisons);
+        v = compareExchange(v, 1, 8, vector_comparisons);
+        return v;
+    }
+
+    // Sorts a bitonic register ascending
+    __attribute__((target("avx2")))
+    static inline __m256i clean8(__m256i v, uint64_t& vector_comparisons) {
+        v = compareExchange(v, 4, 8, vector_comparisons);
+        v = compareExchange(v, 2, 8, vector_comparisons);
+        v = compareExchange(v, 1, 8, vector_comparisons);
+        return v;
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i reverse8(__m256i v) {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+
+    // Merges the sorted runs regs[0, width) and regs[width, 2 * width) into one sorted run
+    __attribute__((target("avx2")))
+    static void mergeRegisters(__m256i* regs, int width, uint64_t& vector_comparisons) {
+        // Comparing the first run with the reversed second run splits them into two
+        // bitonic halves, every element of the lower one below the upper one
+        for (int i = 0; i < width; i++) {
+            __m256i mirrored = reverse8(regs[2 * width - 1 - i]);
+            __m256i low = _mm256_min_epi32(regs[i], mirrored);
+            __m256i high = _mm256_max_epi32(regs[i], mirrored);
+            vector_comparisons++;
+            regs[i] = low;
+            regs[2 * width - 1 - i] = high;
+        }
+        // The upper half was written back in reverse register order; restore it
+        std::reverse(regs + width, regs + 2 * width);
+
+        // Bitonic clean of each half, first across registers, then inside them
+        for (int half = 0; half < 2; half++) {
+            __m256i* run = regs + half * width;
+            for (int step = width / 2; step >= 1; step /= 2) {
+                for (int i = 0; i < width; i++) {
+                    if ((i & step) == 0) {
+                        __m256i low = _mm256_min_epi32(run[i], run[i + step]);
+                        __m256i high = _mm256_max_epi32(run[i], run[i + step]);
+                        vector_comparisons++;
+                        run[i] = low;
+                        run[i + step] = high;
+                    }
+                }
+            }
+            for (int i = 0; i < width; i++) {
+                run[i] = clean8(run[i], vector_comparisons);
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void sortSmallAvx2(int* data, int n, uint64_t& vector_comparisons) {
+        int register_count = 1;
+        while (register_count * 8 < n) {
+            register_count *= 2;
+        }
+
+        alignas(32) int padded[MAX_SMALL_SORT];
+        std::copy(data, data + n, padded);
+        std::fill(padded + n, padded + register_count * 8, INT_MAX);
+
+        __m256i regs[MAX_SMALL_SORT / 8];
+        for (int i = 0; i < register_count; i++) {
+            regs[i] = sort8(_mm256_load_si256(reinterpret_cast<const __m256i*>(padded + 8 * i)), vector_comparisons);
+        }
+        for (int width = 1; width < register_count; width *= 2) {
+            for (int base = 0; base < register_count; base += 2 * width) {
+                mergeRegisters(regs + base, width, vector_comparisons);
+            }
+        }
+        for (int i = 0; i < register_count; i++) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(padded + 8 * i), regs[i]);
+        }
+        std::copy(padded, padded + n, data);
+    }
+
+    __attribute__((target("avx2")))
+    static void mergeAvx2(const int* a, ptrdiff_t n1, const int* b, ptrdiff_t n2, int* dst, uint64_t& comparisons, uint64_t& vector_comparisons) {
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i carry = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        ptrdiff_t i = 8, j = 8, k = 0;
+
+        while (true) {
+            // Bitonic merge of 16 elements: the lower 8 are final, the upper 8 carry over
+            __m256i mirrored = reverse8(carry);
+            __m256i low = _mm256_min_epi32(next, mirrored);
+            __m256i high = _mm256_max_epi32(next, mirrored);
+            vector_comparisons++;
+            low = clean8(low, vector_comparisons);
+            carry = clean8(high, vector_comparisons);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), low);
+            k += 8;
+
+            // Refill from the run with the smaller head, as long as it has a full block
+            bool take_a;
+            if (i < n1 && j < n2) {
+                comparisons++;
+                take_a = a[i] <= b[j];
+            } else if (i < n1 || j < n2) {
+                take_a = i < n1;
+            } else {
+                break;
+            }
+            if (take_a) {
+                if (i + 8 > n1) break;
+                next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                i += 8;
+            } else {
+                if (j + 8 > n2) break;
+                next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+                j += 8;
+            }
+        }
+
+        // Three-way scalar merge of the carried register with both tails
+        alignas(32) int tail[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(tail), carry);
+        int t = 0;
+        while (t < 8 || i < n1 || j < n2) {
+            int source = -1;
+            int best = 0;
+            if (t < 8) { source = 0; best = tail[t]; }
+            if (i < n1) {
+                if (source >= 0) comparisons++;
+                if (source < 0 || a[i] < best) { source = 1; best = a[i]; }
+            }
+            if (j < n2) {
+                if (source >= 0) comparisons++;
+                if (source < 0 || b[j] < best) { source = 2; best = b[j]; }
+            }
+            dst[k++] = best;
+            if (source == 0) t++;
+            else if (source == 1) i++;
+            else j++;
+        }
+    }
+#endif
+};
+
+#endif // SIMD_SORT_H
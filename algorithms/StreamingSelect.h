@@ -0,0 +1,346 @@
+#ifndef STREAMING_SELECT_H
+#define STREAMING_SELECT_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include "../AlgorithmResult.h"
+#include "../AlgorithmRegistry.h"
+#include "../ChunkSource.h"
+
+/**
+ * @class KllSketch
+ * @brief Mergeable quantile sketch (Karnin, Lang & Liberty).
+ *
+ * Items live in a hierarchy of compactors; an item at level h stands for 2^h
+ * input values. When a level overflows its capacity it is sorted and every
+ * other item, starting at a random offset, is promoted to the next level.
+ * Capacities shrink by a factor of 2/3 per level below the top, so the sketch
+ * keeps O(k) items and answers rank queries within about epsilon * n.
+ */
+class KllSketch {
+private:
+    static constexpr double CAPACITY_DECAY = 2.0 / 3.0;
+    static constexpr size_t MIN_CAPACITY = 2;
+
+    size_t k;
+    std::vector<std::vector<int>> compactors;
+    uint64_t count;
+    size_t retained;
+    size_t max_retained;
+    std::mt19937 gen;
+    uint64_t* comparison_count;
+
+    size_t capacity(size_t level) const {
+        size_t depth = compactors.size() - level - 1;
+        size_t cap = static_cast<size_t>(std::ceil(k * std::pow(CAPACITY_DECAY, static_cast<double>(depth))));
+        return std::max(cap, MIN_CAPACITY);
+    }
+
+    // Recomputed whenever a level is added, since that shrinks the levels below
+    void updateCapacity() {
+        max_retained = 0;
+        for (size_t level = 0; level < compactors.size(); level++) {
+            max_retained += capacity(level);
+        }
+    }
+
+    void countingSort(std::vector<int>& items) {
+        uint64_t* counter = comparison_count;
+        std::sort(items.begin(), items.end(), [counter](int a, int b) {
+            if (counter != nullptr) (*counter)++;
+            return a < b;
+        });
+    }
+
+    // Compacts the lowest overflowing level into the one above it
+    void compress() {
+        while (retained > max_retained) {
+            for (size_t level = 0; level < compactors.size(); level++) {
+                if (compactors[level].size() < capacity(level)) {
+                    continue;
+                }
+                if (level + 1 == compactors.size()) {
+                    compactors.emplace_back();
+                    updateCapacity();
+                }
+
+                std::vector<int>& items = compactors[level];
+                countingSort(items);
+
+                // An odd item stays behind so the promoted half stays unbiased
+                int leftover = 0;
+                bool has_leftover = items.size() % 2 == 1;
+                if (has_leftover) {
+                    leftover = items.back();
+                    items.pop_back();
+                }
+
+                size_t offset = std::uniform_int_distribution<size_t>(0, 1)(gen);
+                for (size_t i = offset; i < items.size(); i += 2) {
+                    compactors[level + 1].push_back(items[i]);
+                }
+                retained -= items.size() / 2;
+                items.clear();
+                if (has_leftover) {
+                    items.push_back(leftover);
+                }
+                break;
+            }
+        }
+    }
+
+public:
+    /**
+     * @param epsilon Target rank error as a fraction of the stream length
+     * @param seed Seed of the compaction coin flips
+     */
+    explicit KllSketch(double epsilon, uint64_t seed = std::random_device{}())
+        : k(0), compactors(1), count(0), retained(0), max_retained(0), gen(seed), comparison_count(nullptr) {
+        if (epsilon <= 0.0 || epsilon >= 1.0) {
+            throw std::invalid_argument("epsilon must be in (0, 1)");
+        }
+        k = static_cast<size_t>(std::ceil(2.0 / epsilon));
+        updateCapacity();
+    }
+
+    // Comparisons made while sorting compactors are added to counter
+    void setComparisonCounter(uint64_t* counter) {
+        comparison_count = counter;
+    }
+
+    void update(int value) {
+        compactors[0].push_back(value);
+        count++;
+        retained++;
+        if (retained > max_retained) {
+            compress();
+        }
+    }
+
+    // Folds another sketch built with the same epsilon into this one
+    void merge(const KllSketch& other) {
+        while (compactors.size() < other.compactors.size()) {
+            compactors.emplace_back();
+        }
+        updateCapacity();
+        for (size_t level = 0; level < other.compactors.size(); level++) {
+            compactors[level].insert(compactors[level].end(), other.compactors[level].begin(), other.compactors[level].end());
+        }
+        count += other.count;
+        retained += other.retained;
+        compress();
+    }
+
+    /**
+     * @param q Quantile in [0, 1]
+     * @return An item whose rank is within about epsilon * n of q * n
+     */
+    int quantile(double q) {
+        if (count == 0) {
+            throw std::logic_error("quantile of an empty sketch");
+        }
+
+        std::vector<std::pair<int, uint64_t>> weighted;
+        weighted.reserve(retained);
+        for (size_t level = 0; level < compactors.size(); level++) {
+            for (int item : compactors[level]) {
+                weighted.emplace_back(item, uint64_t(1) << level);
+            }
+        }
+        uint64_t* counter = comparison_count;
+        std::sort(weighted.begin(), weighted.end(), [counter](const auto& a, const auto& b) {
+            if (counter != nullptr) (*counter)++;
+            return a.first < b.first;
+        });
+
+        uint64_t total_weight = 0;
+        for (const auto& item : weighted) {
+            total_weight += item.second;
+        }
+        double target = q * static_cast<double>(total_weight);
+        uint64_t cumulative = 0;
+        for (const auto& item : weighted) {
+            cumulative += item.second;
+            if (static_cast<double>(cumulative) > target) {
+                return item.first;
+            }
+        }
+        return weighted.back().first;
+    }
+
+    uint64_t size() const {
+        return count;
+    }
+
+    size_t memoryUsage() const {
+        size_t total = 0;
+        for (const auto& compactor : compactors) {
+            total += compactor.capacity() * sizeof(int);
+        }
+        return total;
+    }
+};
+
+/**
+ * @class StreamingSelect
+ * @brief Selection over inputs read chunk by chunk from a ChunkSource.
+ *
+ * - topKWithMetrics: exact k-th smallest element through a bounded max-heap of
+ *   the k + 1 smallest values seen so far, O(k) memory
+ * - quantileWithMetrics: approximate quantile through a KllSketch, O(1 / epsilon) memory
+ * - mergedQuantileWithMetrics: the same quantile from one sketch per chunk, merged
+ *   into a running total, as when chunks are sketched where they are produced
+ *
+ * Neither needs the whole input in memory; only one chunk of CHUNK_SIZE values
+ * is buffered at a time.
+ */
+class StreamingSelect {
+public:
+    static constexpr size_t CHUNK_SIZE = 1 << 16;
+
+    /**
+     * @brief Exact k-th smallest element (0-based) of the stream.
+     *
+     * @return AlgorithmResult whose result vector holds the k + 1 smallest values, sorted
+     */
+    static AlgorithmResult topKWithMetrics(ChunkSource& source, size_t k) {
+        auto start_time = std::chrono::steady_clock::now();
+        uint64_t comparisons = 0;
+
+        auto counting_less = [&comparisons](int a, int b) {
+            comparisons++;
+            return a < b;
+        };
+
+        size_t heap_size = k + 1;
+        std::vector<int> heap;
+        heap.reserve(heap_size);
+        std::vector<int> chunk(CHUNK_SIZE);
+
+        size_t read_count;
+        while ((read_count = source.read(chunk.data(), chunk.size())) > 0) {
+            for (size_t i = 0; i < read_count; i++) {
+                int value = chunk[i];
+                if (heap.size() < heap_size) {
+                    heap.push_back(value);
+                    std::push_heap(heap.begin(), heap.end(), counting_less);
+                } else {
+                    // Values not below the current k-th smallest can never enter the answer
+                    comparisons++;
+                    if (value < heap.front()) {
+                        std::pop_heap(heap.begin(), heap.end(), counting_less);
+                        heap.back() = value;
+                        std::push_heap(heap.begin(), heap.end(), counting_less);
+                    }
+                }
+            }
+        }
+
+        if (heap.size() < heap_size)
+            throw std::out_of_range("k is out of bounds");
+
+        int result = heap.front();
+        std::sort_heap(heap.begin(), heap.end(), counting_less);
+
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        size_t memory_used = sizeof(int) * (heap.capacity() + chunk.capacity());
+
+        AlgorithmResult algorithm_result = AlgorithmResult::forMultiSelection("StreamingTopK", std::move(heap), execution_time, comparisons, memory_used);
+        algorithm_result.value = result;
+        return algorithm_result;
+    }
+
+    /**
+     * @brief Approximate q-quantile of the stream with rank error of about epsilon * n.
+     */
+    static AlgorithmResult quantileWithMetrics(ChunkSource& source, double q, double epsilon) {
+        auto start_time = std::chrono::steady_clock::now();
+        uint64_t comparisons = 0;
+
+        KllSketch sketch(epsilon);
+        sketch.setComparisonCounter(&comparisons);
+        std::vector<int> chunk(CHUNK_SIZE);
+
+        size_t read_count;
+        while ((read_count = source.read(chunk.data(), chunk.size())) > 0) {
+            for (size_t i = 0; i < read_count; i++) {
+                sketch.update(chunk[i]);
+            }
+        }
+
+        int result = sketch.quantile(q);
+
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        size_t memory_used = sketch.memoryUsage() + sizeof(int) * chunk.capacity();
+
+        return AlgorithmResult::forSelection("StreamingQuantile", result, execution_time, comparisons, memory_used);
+    }
+
+    /**
+     * @brief Approximate q-quantile of the stream from per-chunk sketches: every chunk
+     * is summarized by its own KllSketch, which is then merged into the total sketch.
+     * The rank error stays about epsilon * n, as merging keeps KLL's guarantee.
+     */
+    static AlgorithmResult mergedQuantileWithMetrics(ChunkSource& source, double q, double epsilon) {
+        auto start_time = std::chrono::steady_clock::now();
+        uint64_t comparisons = 0;
+
+        KllSketch total(epsilon);
+        total.setComparisonCounter(&comparisons);
+        std::vector<int> chunk(CHUNK_SIZE);
+        size_t peak_chunk_sketch = 0;
+
+        size_t read_count;
+        while ((read_count = source.read(chunk.data(), chunk.size())) > 0) {
+            KllSketch chunk_sketch(epsilon);
+            chunk_sketch.setComparisonCounter(&comparisons);
+            for (size_t i = 0; i < read_count; i++) {
+                chunk_sketch.update(chunk[i]);
+            }
+            peak_chunk_sketch = std::max(peak_chunk_sketch, chunk_sketch.memoryUsage());
+            total.merge(chunk_sketch);
+        }
+
+        int result = total.quantile(q);
+
+        auto end_time = std::chrono::steady_clock::now();
+        double execution_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        size_t memory_used = total.memoryUsage() + peak_chunk_sketch + sizeof(int) * chunk.capacity();
+
+        return AlgorithmResult::forSelection("MergedStreamingQuantile", result, execution_time, comparisons, memory_used);
+    }
+};
+
+// Engines registered with the benchmark (see AlgorithmRegistry.h); they read the
+// input as if it were a stream, through a ChunkSource over the working copy
+inline bool registerStreamingSelectEngines() {
+    AlgorithmRegistry::add({"streaming_top_k", "Streaming Top-K", SELECTS, [](size_t) -> AlgorithmRunner {
+        return [](const AlgorithmRequest& request) {
+            VectorChunkSource source(request.data);
+            return StreamingSelect::topKWithMetrics(source, request.k);
+        };
+    }});
+    constexpr double epsilon = 0.01;
+    AlgorithmRegistry::add({"streaming_kll_median", "Streaming KLL Median", SELECTS | APPROXIMATE, [=](size_t) -> AlgorithmRunner {
+        return [=](const AlgorithmRequest& request) {
+            VectorChunkSource source(request.data);
+            return StreamingSelect::quantileWithMetrics(source, 0.5, epsilon);
+        };
+    }, 0.5, epsilon});
+    return true;
+}
+
+inline const bool streaming_select_engines_registered = registerStreamingSelectEngines();
+
+#endif // STREAMING_SELECT_H
@@ -1,64 +1,42 @@
+// Installs the counting operator new/delete used for memory measurements
+#define MEMORY_TRACKER_IMPLEMENTATION
 #include "Benchmark.h"
+#include "BenchmarkHarness.h"
+#include "BenchmarkRunner.h"
 #include <cstddef>
 #include <iostream>
 #include <cstdlib>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
-void run_benchmark_suite(size_t execution_count) {
-    std::vector<BenchmarkConfig> configurations = {
-        // {AlgorithmType::SELECTION, 100000, TestCaseType::NEARLY_SORTED, "SELECTION 100K NEARLY_SORTED"},
-        // {AlgorithmType::SELECTION, 100000, TestCaseType::RANDOM, "SELECTION 100K RANDOM"},
-        // {AlgorithmType::SELECTION, 100000, TestCaseType::REVERSE_SORTED, "SELECTION 100K REVERSE_SORTED"},
-        // {AlgorithmType::SELECTION, 500000, TestCaseType::NEARLY_SORTED, "SELECTION 500K NEARLY_SORTED"},
-        // {AlgorithmType::SELECTION, 500000, TestCaseType::RANDOM, "SELECTION 500K RANDOM"},
-        // {AlgorithmType::SELECTION, 500000, TestCaseType::REVERSE_SORTED, "SELECTION 500K REVERSE_SORTED"},
-        // {AlgorithmType::SELECTION, 1000000, TestCaseType::NEARLY_SORTED, "SELECTION 1M NEARLY_SORTED"},
-        // {AlgorithmType::SELECTION, 1000000, TestCaseType::RANDOM, "SELECTION 1M RANDOM"},
-        // {AlgorithmType::SELECTION, 1000000, TestCaseType::REVERSE_SORTED, "SELECTION 1M REVERSE_SORTED"},
-        // {AlgorithmType::SORTING, 100000, TestCaseType::NEARLY_SORTED, "SORTING 100K NEARLY_SORTED"},
-        // {AlgorithmType::SORTING, 100000, TestCaseType::RANDOM, "SORTING 100K RANDOM"},
-        // {AlgorithmType::SORTING, 100000, TestCaseType::REVERSE_SORTED, "SORTING 100K REVERSE_SORTED"},
-        // {AlgorithmType::SORTING, 500000, TestCaseType::NEARLY_SORTED, "SORTING 500K NEARLY_SORTED"},
-        // {AlgorithmType::SORTING, 500000, TestCaseType::RANDOM, "SORTING 500K RANDOM"},
-        // {AlgorithmType::SORTING, 500000, TestCaseType::REVERSE_SORTED, "SORTING 500K REVERSE_SORTED"},
-        // {AlgorithmType::SORTING, 1000000, TestCaseType::NEARLY_SORTED, "SORTING 1M NEARLY_SORTED"},
-        {AlgorithmType::SORTING, 1000000, TestCaseType::RANDOM, "SORTING 1M RANDOM"},
-        // {AlgorithmType::SORTING, 1000000, TestCaseType::REVERSE_SORTED, "SORTING 1M REVERSE_SORTED"}
-    };
+int main(int argc, char** argv) {
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments.empty()) {
+        arguments.push_back("benchmarks.conf");
+    }
 
-    for (const auto& config : configurations) {
-        std::cout << "\n=== Starting benchmark: " << config.test_name << " ===\n";
-        
-        for (size_t i = 0; i < execution_count; i++) {
-            try {
-                Benchmark::run_benchmark(config);
-                
-                // Print progress every 10%
-                if ((i + 1) % (execution_count / 10) == 0) {
-                    int progress = ((i + 1) * 100) / execution_count;
-                    std::cout << "[" << config.test_name << "] " << progress << "% completed (" 
-                              << (i + 1) << "/" << execution_count << ")\n";
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error in " << config.test_name << " (iteration " << i + 1 << "): " 
-                          << e.what() << "\n";
-                return;
-            }
-        }
-        
-        std::cout << "=== Completed benchmark: " << config.test_name << " ===\n";
+    BenchmarkRunner::Plan plan;
+    try {
+        plan = BenchmarkRunner::parseArguments(arguments);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << "\n"
+                  << "Usage: " << argv[0] << " [config files] [type key=value...] [setting=value...]\n"
+                  << "  e.g. " << argv[0] << " sorting sizes=1M cases=random threads=1,2,4 repetitions=10:100\n";
+        return 2;
+    }
+
+    const HarnessOptions& options = plan.settings.harness;
+    std::cout << "Starting benchmark suite: " << options.warmup_iterations << " warmup iterations, "
+              << options.min_repetitions << "-" << options.max_repetitions << " repetitions per test case until the "
+              << options.confidence * 100 << "% confidence interval is within " << options.target_relative_error * 100
+              << "% of the mean\n\n";
+
+    if (!BenchmarkRunner::run(plan)) {
+        std::cerr << "\nSome benchmarks failed\n";
+        return 1;
     }
-}
 
-int main() {
-    const size_t execution_count = 100000;
-    
-    std::cout << "Starting benchmark suite with " << execution_count << " executions per test case\n";
-    std::cout << "Total test cases: 18 (2 algorithms * 3 sizes * 3 test cases)\n";
-    std::cout << "Estimated time: This may take a while...\n\n";
-    
-    run_benchmark_suite(execution_count);
-    
     std::cout << "\nAll benchmarks completed successfully!\n";
     return 0;
 }
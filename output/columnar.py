@@ -0,0 +1,82 @@
+"""Reader for the binary columnar benchmark files (*_benchmark.bin) written by ResultSink.h."""
+import struct
+from pathlib import Path
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b'BCOL0001'
+INT64, FLOAT64, STRING = 0, 1, 2
+# Missing integer values are stored as the smallest int64
+NULL_INT = np.iinfo(np.int64).min
+
+
+def read_columnar(path):
+    """Load every row group of a columnar file into one DataFrame, missing values as NaN."""
+    data = Path(path).read_bytes()
+    if data[:8] != MAGIC:
+        raise ValueError(f'{path} is not a columnar benchmark file')
+    offset = 8
+    (column_count,) = struct.unpack_from('<I', data, offset)
+    offset += 4
+
+    schema = []
+    for _ in range(column_count):
+        column_type, name_length = struct.unpack_from('<BH', data, offset)
+        offset += 3
+        schema.append((data[offset:offset + name_length].decode('utf-8'), column_type))
+        offset += name_length
+
+    chunks = {name: [] for name, _ in schema}
+    while offset < len(data):
+        (rows,) = struct.unpack_from('<Q', data, offset)
+        offset += 8
+        for name, column_type in schema:
+            if column_type == STRING:
+                values = []
+                for _ in range(rows):
+                    (length,) = struct.unpack_from('<I', data, offset)
+                    offset += 4
+                    values.append(data[offset:offset + length].decode('utf-8'))
+                    offset += length
+                chunks[name].append(np.array(values, dtype=object))
+            else:
+                dtype = '<i8' if column_type == INT64 else '<f8'
+                values = np.frombuffer(data, dtype=dtype, count=rows, offset=offset)
+                offset += rows * 8
+                if column_type == INT64 and (values == NULL_INT).any():
+                    values = np.where(values == NULL_INT, np.nan, values)
+                chunks[name].append(values)
+
+    return pd.DataFrame({name: np.concatenate(parts) if parts else [] for name, parts in chunks.items()})
+
+
+# Metrics the analysis scripts read, one column per algorithm in the wide layout
+WIDE_METRICS = ['Execution Time (ms)', 'Comparisons', 'Memory Usage (bytes)']
+
+
+def to_wide(df):
+    """Turn long rows (one per algorithm run) into one row per iteration with a
+    '<metric> <algorithm>' column per algorithm, the layout of older files."""
+    wide = df.pivot_table(index=['Test Case', 'Input Size', 'Run'], columns='Algorithm',
+                          values=WIDE_METRICS, aggfunc='first', sort=False)
+    wide.columns = [f'{metric} {algorithm}' for metric, algorithm in wide.columns]
+    return wide.reset_index().drop(columns='Run')
+
+
+def load_benchmark_file(csv_path):
+    """Prefer the columnar twin of a *_benchmark.csv file when it exists, it loads much faster.
+    Long-format files are returned in the wide layout, see to_wide."""
+    csv_path = Path(csv_path)
+    columnar_path = csv_path.with_suffix('.bin')
+    df = read_columnar(columnar_path) if columnar_path.exists() else pd.read_csv(csv_path)
+    if 'Algorithm' in df.columns:
+        df = to_wide(df)
+    return df
+
+
+def find_benchmark_files(output_dir, pattern):
+    """*_benchmark.csv files matching pattern, plus columnar files that have no CSV twin."""
+    files = list(output_dir.glob(f'{pattern}.csv'))
+    files += [f.with_suffix('.csv') for f in output_dir.glob(f'{pattern}.bin') if not f.with_suffix('.csv').exists()]
+    return files
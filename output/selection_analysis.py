@@ -2,6 +2,7 @@ import pandas as pd
 import matplotlib.pyplot as plt
 from pathlib import Path
 import numpy as np
+from columnar import find_benchmark_files, load_benchmark_file
 
 # Output directory
 output_dir = Path(__file__).parent
@@ -10,14 +11,22 @@ output_dir = Path(__file__).parent
 size_map = {
     '100k': 100000,
     '500k': 500000,
-    '1000k': 1000000
+    '1000k': 1000000,
+    '10000k': 10000000,
+    '100000k': 100000000
 }
 
 # Test case order
 test_case_order = {
     'random': 1,
     'nearly_sorted': 2,
-    'reverse_sorted': 3
+    'reverse_sorted': 3,
+    'few_unique': 4,
+    'zipf': 5,
+    'organ_pipe': 6,
+    'sawtooth': 7,
+    'sorted_runs': 8,
+    'all_equal': 9
 }
 
 def load_and_process_data():
@@ -26,7 +35,7 @@ def load_and_process_data():
     print("Arquivos encontrados:")
     
     # Find all selection benchmark files
-    benchmark_files = list(output_dir.glob('selection_*_benchmark.csv'))
+    benchmark_files = find_benchmark_files(output_dir, 'selection_*_benchmark')
     for file in benchmark_files:
         print(f"- {file.name}")
     
@@ -51,8 +60,8 @@ def load_and_process_data():
                 print(f"  Pular: {file.name} - Tamanho ou caso de teste inválido")
                 continue
                 
-            # Read CSV file
-            df = pd.read_csv(file)
+            # Read the columnar file when present, the CSV otherwise
+            df = load_benchmark_file(file)
             
             # Add test case and size columns
             df['test_case'] = test_case
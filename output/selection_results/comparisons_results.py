@@ -10,7 +10,9 @@ output_dir = Path(__file__).parent
 size_map = {
     '100k': 100000,
     '500k': 500000,
-    '1000k': 1000000
+    '1000k': 1000000,
+    '10000k': 10000000,
+    '100000k': 100000000
 }
 
 # Ordem dos casos de teste
@@ -13,7 +13,9 @@ dfs = []
 size_map = {
     '100k': 100000,
     '500k': 500000,
-    '1000k': 1000000
+    '1000k': 1000000,
+    '10000k': 10000000,
+    '100000k': 100000000
 }
 
 # Mapeamento de casos de teste para ordem de exibição